@@ -0,0 +1,48 @@
+//
+//  bench.hpp
+//  toybox - bench
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/cincludes.hpp"
+#include "core/utility.hpp"
+
+using namespace toybox;
+
+/**
+ Minimal benchmark runner for toybox hot paths.
+ Each benchmark is calibrated to run for a minimum duration, and the best of
+ several runs is reported as nanoseconds per operation.
+ */
+namespace bench {
+    
+    using bench_f = function_c<void(int iterations)>;
+    
+    /// Run `func` with an iteration count, `ops` operations are performed per iteration.
+    void run_func(const char* name, bench_f func, int ops);
+    template<typename F>
+    __forceinline void run(const char* name, F&& func, int ops = 1) {
+        bench_f f(func);
+        run_func(name, f, ops);
+    }
+    
+    /// Print a machine readable summary of all benchmarks run.
+    void print_summary();
+
+    /// Prevent the compiler from optimizing away a value, or writes to it.
+    template<typename T>
+    __forceinline void do_not_optimize(T& value) {
+        __asm__ volatile ("" : : "g"(&value) : "memory");
+    }
+    
+}
+
+// Benchmark function declarations
+void bench_collections();
+void bench_allocators();
+void bench_dirtymap();
+void bench_canvas();
+void bench_tilemap_level();
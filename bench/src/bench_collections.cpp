@@ -0,0 +1,213 @@
+//
+//  bench_collections.cpp
+//  toybox - bench
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "bench.hpp"
+#include "core/vector.hpp"
+#include "core/map.hpp"
+#include "core/hash_map.hpp"
+#include "core/list.hpp"
+#include "core/bitset.hpp"
+#include "core/pool_allocator.hpp"
+#include "core/frame_arena.hpp"
+
+static constexpr int element_count = 64;
+
+__neverinline void bench_collections() {
+    printf("== Start: bench_collections\n\r");
+    
+    bench::run("vector_c push_back", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            vector_c<int, 0> vec;
+            for (int j = 0; j < element_count; ++j) {
+                vec.push_back(j);
+            }
+            bench::do_not_optimize(vec);
+        }
+    }, element_count);
+    
+    bench::run("vector_c insert front", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            vector_c<int, element_count> vec;
+            for (int j = 0; j < element_count; ++j) {
+                vec.insert(0, j);
+            }
+            bench::do_not_optimize(vec);
+        }
+    }, element_count);
+
+    bench::run("vector_c erase front", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            vector_c<int, element_count> vec;
+            for (int j = 0; j < element_count; ++j) {
+                vec.push_back(j);
+            }
+            while (vec.size() > 0) {
+                vec.erase(0);
+            }
+            bench::do_not_optimize(vec);
+        }
+    }, element_count);
+
+    bench::run("map_c insert/erase", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            map_c<int16_t, int, element_count> map;
+            for (int j = 0; j < element_count; ++j) {
+                map.insert({ (int16_t)((j * 37) & (element_count - 1)), j });
+            }
+            for (int j = 0; j < element_count; ++j) {
+                map.erase((int16_t)((j * 11) & (element_count - 1)));
+            }
+            bench::do_not_optimize(map);
+        }
+    }, element_count * 2);
+
+    bench::run("hash_map_c insert/erase", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            hash_map_c<int16_t, int, element_count * 2> map;
+            for (int j = 0; j < element_count; ++j) {
+                map.insert({ (int16_t)((j * 37) & (element_count - 1)), j });
+            }
+            for (int j = 0; j < element_count; ++j) {
+                map.erase((int16_t)((j * 11) & (element_count - 1)));
+            }
+            bench::do_not_optimize(map);
+        }
+    }, element_count * 2);
+
+    bench::run("list_c traverse", [](int iterations) {
+        list_c<int, element_count> list;
+        for (int j = 0; j < element_count; ++j) {
+            list.push_front(j);
+        }
+        for (int i = 0; i < iterations; ++i) {
+            int sum = 0;
+            for (const auto& value : list) {
+                sum += value;
+            }
+            bench::do_not_optimize(sum);
+        }
+    }, element_count);
+    
+    static constexpr int sort_count = 256;
+    static int16_t s_source[sort_count];
+    static int16_t s_values[sort_count];
+    static int16_t s_scratch[sort_count];
+    uint16_t seed = 1;
+    for (auto& value : s_source) {
+        seed = seed * 25173 + 13849;
+        value = (int16_t)seed;
+    }
+
+    bench::run("sort int16_t", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            copy(begin(s_source), end(s_source), begin(s_values));
+            sort(begin(s_values), end(s_values));
+        }
+    }, sort_count);
+
+    bench::run("stable_sort int16_t", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            copy(begin(s_source), end(s_source), begin(s_values));
+            stable_sort(begin(s_values), end(s_values), s_scratch, [](int16_t a, int16_t b) { return a < b; });
+        }
+    }, sort_count);
+
+    bench::run("radix_sort int16_t", [](int iterations) {
+        for (int i = 0; i < iterations; ++i) {
+            copy(begin(s_source), end(s_source), begin(s_values));
+            radix_sort(begin(s_values), end(s_values), s_scratch, [](int16_t v) { return (uint16_t)(v ^ 0x8000); });
+        }
+    }, sort_count);
+
+    bench::run("bitset_array_c iterate sparse", [](int iterations) {
+        bitset_array_c<512> bits;
+        for (int j = 0; j < 512; j += 37) {
+            bits.set(j);
+        }
+        for (int i = 0; i < iterations; ++i) {
+            int sum = 0;
+            for (const int bit : bits) {
+                sum += bit;
+            }
+            bench::do_not_optimize(sum);
+        }
+    });
+
+    printf("bench_collections done.\n\r");
+}
+
+__neverinline void bench_allocators() {
+    printf("== Start: bench_allocators\n\r");
+
+    bench::run("pool_allocator_c static", [](int iterations) {
+        using allocator = pool_allocator_c<uint8_t[24], element_count>;
+        void* ptrs[element_count];
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < element_count; ++j) {
+                ptrs[j] = allocator::allocate();
+            }
+            for (int j = 0; j < element_count; ++j) {
+                allocator::deallocate(ptrs[j]);
+            }
+            bench::do_not_optimize(ptrs);
+        }
+    }, element_count);
+
+    bench::run("pool_allocator_c dynamic", [](int iterations) {
+        using allocator = pool_allocator_c<uint8_t[24], 0>;
+        void* ptrs[element_count];
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < element_count; ++j) {
+                ptrs[j] = allocator::allocate();
+            }
+            for (int j = 0; j < element_count; ++j) {
+                allocator::deallocate(ptrs[j]);
+            }
+            bench::do_not_optimize(ptrs);
+        }
+    }, element_count);
+
+    bench::run("frame_arena_c allocate", [](int iterations) {
+        void* ptrs[element_count];
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < element_count; ++j) {
+                ptrs[j] = frame_arena_c::allocate(24);
+            }
+            frame_arena_c::reset();
+            bench::do_not_optimize(ptrs);
+        }
+    }, element_count);
+
+    bench::run("_malloc/_free 24 bytes", [](int iterations) {
+        void* ptrs[element_count];
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < element_count; ++j) {
+                ptrs[j] = _malloc(24);
+            }
+            for (int j = 0; j < element_count; ++j) {
+                _free(ptrs[j]);
+            }
+            bench::do_not_optimize(ptrs);
+        }
+    }, element_count);
+
+    bench::run("operator new/delete 24 bytes", [](int iterations) {
+        struct object_s { uint8_t data[24]; };
+        object_s* ptrs[element_count];
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < element_count; ++j) {
+                ptrs[j] = new object_s();
+            }
+            for (int j = 0; j < element_count; ++j) {
+                delete ptrs[j];
+            }
+            bench::do_not_optimize(ptrs);
+        }
+    }, element_count);
+
+    printf("bench_allocators done.\n\r");
+}
@@ -0,0 +1,117 @@
+//
+//  bench_media.cpp
+//  toybox - bench
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "bench.hpp"
+#include "machine/blitter_atari.hpp"
+#include "media/canvas.hpp"
+#include "media/dirtymap.hpp"
+#include "media/tileset.hpp"
+
+static constexpr size_s screen_size = size_s(320, 208);
+
+__neverinline void bench_dirtymap() {
+    printf("== Start: bench_dirtymap\n\r");
+    
+    bench::run("dirtymap_c mark", [](int iterations) {
+        auto dirtymap = dirtymap_c::create(screen_size);
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < 16; ++j) {
+                dirtymap->mark(rect_s((j * 19) & 255, (j * 11) & 127, 32, 32));
+            }
+            dirtymap->clear();
+        }
+        _free(dirtymap);
+    }, 16);
+
+    bench::run("dirtymap_c merge", [](int iterations) {
+        auto dirtymap = dirtymap_c::create(screen_size);
+        auto other = dirtymap_c::create(screen_size);
+        other->mark(rect_s(16, 16, 128, 96));
+        for (int i = 0; i < iterations; ++i) {
+            dirtymap->merge(*other);
+            bench::do_not_optimize(*dirtymap);
+        }
+        _free(other);
+        _free(dirtymap);
+    });
+
+    bench::run("dirtymap_c restore", [](int iterations) {
+        image_c image(screen_size, false, nullptr);
+        image_c clean_image(screen_size, false, nullptr);
+        canvas_c canvas(image);
+        auto dirtymap = dirtymap_c::create(screen_size);
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < 16; ++j) {
+                dirtymap->mark(rect_s((j * 19) & 255, (j * 11) & 127, 32, 32));
+            }
+            dirtymap->restore(canvas, clean_image);
+        }
+        _free(dirtymap);
+    });
+
+    printf("bench_dirtymap done.\n\r");
+}
+
+__neverinline void bench_canvas() {
+    printf("== Start: bench_canvas\n\r");
+
+    bench::run("blitter_s fill screen", [](int iterations) {
+        const int16_t line_words = screen_size.width / 16 * 4;
+        auto bitmap = (uint16_t*)_calloc(line_words * screen_size.height, sizeof(uint16_t));
+        for (int i = 0; i < iterations; ++i) {
+            pBlitter->endMask[0] = 0xffff;
+            pBlitter->endMask[1] = 0xffff;
+            pBlitter->endMask[2] = 0xffff;
+            pBlitter->dstIncX = 2;
+            pBlitter->dstIncY = 2;
+            pBlitter->pDst = bitmap;
+            pBlitter->countX = line_words;
+            pBlitter->countY = screen_size.height;
+            pBlitter->HOP = blitter_s::hop_e::one;
+            pBlitter->LOP = blitter_s::lop_e::one;
+            pBlitter->skew = 0;
+            pBlitter->start();
+        }
+        _free(bitmap);
+    });
+
+    bench::run("canvas_c fill", [](int iterations) {
+        image_c image(screen_size, false, nullptr);
+        canvas_c canvas(image);
+        for (int i = 0; i < iterations; ++i) {
+            canvas.fill(i & 15, rect_s(3, 5, 301, 181));
+        }
+    });
+
+    bench::run("canvas_c draw masked", [](int iterations) {
+        image_c image(screen_size, false, nullptr);
+        image_c sprite(size_s(32, 32), true, nullptr);
+        canvas_c canvas(image);
+        for (int i = 0; i < iterations; ++i) {
+            for (int j = 0; j < 16; ++j) {
+                canvas.draw(sprite, point_s((j * 19) & 255, (j * 11) & 127));
+            }
+        }
+    }, 16);
+
+    bench::run("canvas_c draw_tile", [](int iterations) {
+        image_c image(screen_size, false, nullptr);
+        tileset_c tileset(new image_c(size_s(320, 32), false, nullptr), size_s(16, 16));
+        canvas_c canvas(image);
+        for (int i = 0; i < iterations; ++i) {
+            canvas.with_tileset(tileset, [&] {
+                for (int y = 0; y < 13; ++y) {
+                    for (int x = 0; x < 20; ++x) {
+                        canvas.draw_tile(tileset, (x + y) % tileset.max_index(), point_s(x * 16, y * 16));
+                    }
+                }
+            });
+        }
+    }, 20 * 13);
+
+    printf("bench_canvas done.\n\r");
+}
@@ -0,0 +1,60 @@
+//
+//  bench_runtime.cpp
+//  toybox - bench
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "bench.hpp"
+#include "media/viewport.hpp"
+#include "media/dirtymap.hpp"
+#include "runtime/tilemap_level.hpp"
+
+static constexpr int entity_count = 16;
+
+static void move_action(tilemap_level_c& level, entity_s& entity, bool event) {
+    auto& origin = entity.position.origin;
+    origin.x += 1;
+    if (entity_s::coord_t(288) < origin.x) {
+        origin.x = 0;
+    }
+}
+
+static tilemap_level_c& make_level() {
+    // Levels are never destroyed, a single synthetic level is shared by all runs.
+    static tileset_c s_tileset(new image_c(size_s(320, 32), false, nullptr), size_s(16, 16));
+    static tilemap_level_c* s_level = nullptr;
+    if (!s_level) {
+        s_level = new tilemap_level_c(rect_s(0, 0, 20, 13), &s_tileset);
+        for (int y = 0; y < 13; ++y) {
+            for (int x = 0; x < 20; ++x) {
+                (*s_level)[x, y].index = (x + y) & 1 ? (x + y) % s_tileset.max_index() : 0;
+            }
+        }
+        s_level->add_action(&actions::idle);
+        const int move_idx = s_level->add_action(&move_action).first;
+        auto& type_def = s_level->add_entity_type_def(&s_tileset).second;
+        type_def.frame_defs.push_back({ 1, rect_s(0, 0, 16, 16) });
+        for (int i = 0; i < entity_count; ++i) {
+            auto& entity = s_level->spawn_entity(0, 0, static_cast<entity_s::rect_t>(rect_s((i * 37) % 288, (i * 11) % 176, 16, 16)));
+            entity.action = move_idx;
+        }
+    }
+    return *s_level;
+}
+
+__neverinline void bench_tilemap_level() {
+    printf("== Start: bench_tilemap_level\n\r");
+
+    bench::run("tilemap_level_c update", [](int iterations) {
+        auto& level = make_level();
+        viewport_c viewport;
+        for (int i = 0; i < iterations; ++i) {
+            // Skip merging into scene manager display lists, there is none headless.
+            level.tiles_dirtymap().clear();
+            level.update(viewport, 0, 1);
+        }
+    });
+
+    printf("bench_tilemap_level done.\n\r");
+}
@@ -0,0 +1,39 @@
+//
+//  main.cpp
+//  toybox - bench
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "bench.hpp"
+#include "machine/machine.hpp"
+
+static int run_benchmarks() {
+    // Benchmark core collections and allocators
+    bench_collections();
+    bench_allocators();
+    
+    // Benchmark media primitives
+    bench_dirtymap();
+    bench_canvas();
+    
+    // Benchmark runtime
+    bench_tilemap_level();
+    
+    bench::print_summary();
+    return 0;
+}
+
+int main(int argc, const char* argv[]) {
+#ifndef TOYBOX_HOST
+    // Target needs supervisor mode for blitter and the 200Hz counter.
+    int r = machine_c::with_machine(argc, argv, [] (machine_c& m) {
+        return run_benchmarks();
+    });
+    while (getc(stdin) != ' ');
+    return r;
+#else
+    // Host runs headless, no machine or host bridge is needed.
+    return run_benchmarks();
+#endif
+}
@@ -0,0 +1,66 @@
+//
+//  runner.cpp
+//  toybox - bench
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "bench.hpp"
+#include "core/vector.hpp"
+
+namespace bench {
+    
+    struct result_s {
+        const char* name;
+        int32_t iterations;
+        int ops;
+        int64_t ns_per_op;
+    };
+    static vector_c<result_s, 64> s_results;
+
+#ifdef __M68000__
+    // Runs in supervisor mode, read _hz_200 directly, 5ms resolution.
+    static constexpr int64_t min_duration_ns = 1000000000;
+    static __forceinline int64_t now_ns() {
+        return (int64_t)*((volatile uint32_t*)0x4ba) * 5000000;
+    }
+#else
+    static constexpr int64_t min_duration_ns = 50000000;
+    static __forceinline int64_t now_ns() {
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (int64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+    }
+#endif
+    static constexpr int repeat_count = 5;
+
+    static int64_t time_iterations(bench_f& func, int32_t iterations) {
+        const int64_t start = now_ns();
+        func(iterations);
+        return now_ns() - start;
+    }
+    
+    void run_func(const char* name, bench_f func, int ops) {
+        // Calibrate iteration count to run for at least min_duration_ns.
+        int32_t iterations = 1;
+        while (time_iterations(func, iterations) < min_duration_ns && iterations < (INT32_MAX / 2)) {
+            iterations *= 2;
+        }
+        // Best of several runs is the most repeatable measure.
+        int64_t best = INT64_MAX;
+        for (int i = 0; i < repeat_count; ++i) {
+            best = MIN(best, time_iterations(func, iterations));
+        }
+        const int64_t ns_per_op = best / ((int64_t)iterations * ops);
+        s_results.push_back((result_s){ name, iterations, ops, ns_per_op });
+        printf("%-32s %10ld ns/op (%ld x %d ops)\n\r", name, (long)ns_per_op, (long)iterations, ops);
+    }
+    
+    void print_summary() {
+        printf("# name,iterations,ops,ns_per_op\n\r");
+        for (const auto& result : s_results) {
+            printf("%s,%ld,%d,%ld\n\r", result.name, (long)result.iterations, result.ops, (long)result.ns_per_op);
+        }
+    }
+    
+}
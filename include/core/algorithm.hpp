@@ -59,6 +59,21 @@ namespace toybox {
         return d_first;
     }
 
+    /// Move [first, last) into uninitialized non-overlapping d_first, and
+    /// destroy the source. Trivially relocatable types are copied as bytes.
+    template<class T>
+    T* uninitialized_relocate(T* first, T* last, T* d_first) {
+        if constexpr (is_trivially_relocatable<T>::value) {
+            const auto count = last - first;
+            memcpy(static_cast<void*>(d_first), static_cast<const void*>(first), count * sizeof(T));
+            return d_first + count;
+        } else {
+            d_first = uninitialized_move(first, last, d_first);
+            destroy(first, last);
+            return d_first;
+        }
+    }
+
     template<const_forward_iterator I, forward_iterator J>
     J uninitialized_copy(I first, I last, J d_first) {
         while (first != last) {
@@ -138,10 +153,257 @@ namespace toybox {
         }
     }
 
+    namespace detail {
+        // Stable insertion sort, used for small ranges by sort and stable_sort
+        template<random_access_iterator I, typename Comp>
+        void insertion_sort(I first, I last, Comp comp) {
+            if (first == last) return;
+            for (I i = first + 1; i != last; ++i) {
+                auto key = move(*i);
+                I j = i;
+                while (j != first && comp(key, *(j - 1))) {
+                    *j = move(*(j - 1));
+                    --j;
+                }
+                *j = move(key);
+            }
+        }
+
+        template<random_access_iterator I, typename Comp>
+        void sift_down(I first, int start, int count, Comp comp) {
+            int root = start;
+            while (true) {
+                int child = root * 2 + 1;
+                if (child >= count) return;
+                if (child + 1 < count && comp(first[child], first[child + 1])) {
+                    child++;
+                }
+                if (!comp(first[root], first[child])) return;
+                swap(first[root], first[child]);
+                root = child;
+            }
+        }
+
+        template<random_access_iterator I, typename Comp>
+        void heap_sort(I first, I last, Comp comp) {
+            const int count = last - first;
+            for (int start = count / 2 - 1; start >= 0; --start) {
+                sift_down(first, start, count, comp);
+            }
+            for (int end = count - 1; end > 0; --end) {
+                swap(first[0], first[end]);
+                sift_down(first, 0, end, comp);
+            }
+        }
+
+        // Moves median of a, b and c into result
+        template<random_access_iterator I, typename Comp>
+        void move_median_to_first(I result, I a, I b, I c, Comp comp) {
+            if (comp(*a, *b)) {
+                if (comp(*b, *c)) swap(*result, *b);
+                else if (comp(*a, *c)) swap(*result, *c);
+                else swap(*result, *a);
+            } else if (comp(*a, *c)) {
+                swap(*result, *a);
+            } else if (comp(*b, *c)) {
+                swap(*result, *c);
+            } else {
+                swap(*result, *b);
+            }
+        }
+
+        // Hoare partition around median of three, returns first element of upper partition
+        template<random_access_iterator I, typename Comp>
+        I partition_pivot(I first, I last, Comp comp) {
+            I mid = first + (last - first) / 2;
+            move_median_to_first(first, first + 1, mid, last - 1, comp);
+            I left = first + 1;
+            I right = last;
+            while (true) {
+                while (comp(*left, *first)) ++left;
+                --right;
+                while (comp(*first, *right)) --right;
+                if (!(left < right)) return left;
+                swap(*left, *right);
+                ++left;
+            }
+        }
+
+        static constexpr int sort_threshold = 16;
+
+        template<random_access_iterator I, typename Comp>
+        void introsort_loop(I first, I last, int depth, Comp comp) {
+            while (last - first > sort_threshold) {
+                if (depth == 0) {
+                    heap_sort(first, last, comp);
+                    return;
+                }
+                --depth;
+                I cut = partition_pivot(first, last, comp);
+                introsort_loop(cut, last, depth, comp);
+                last = cut;
+            }
+        }
+
+        __forceinline int sort_depth_limit(int count) {
+            int depth = 0;
+            while (count > 1) {
+                count >>= 1;
+                depth += 2;
+            }
+            return depth;
+        }
+
+        template<random_access_iterator I, typename T, typename Comp>
+        void merge_sort(I first, I last, T* scratch, Comp comp) {
+            const int count = last - first;
+            if (count <= sort_threshold) {
+                insertion_sort(first, last, comp);
+                return;
+            }
+            I mid = first + count / 2;
+            merge_sort(first, mid, scratch, comp);
+            merge_sort(mid, last, scratch, comp);
+            if (!comp(*mid, *(mid - 1))) return;  // Already in order
+            T* scratch_end = move(first, mid, scratch);
+            T* left = scratch;
+            I right = mid;
+            I out = first;
+            while (left != scratch_end && right != last) {
+                if (comp(*right, *left)) {
+                    *out = move(*right); ++right;
+                } else {
+                    *out = move(*left); ++left;
+                }
+                ++out;
+            }
+            move(left, scratch_end, out);
+        }
+    }
+
+    // Introsort, O(n log n) worst case, quicksort with heapsort fallback and insertion sort for small ranges
+    template<random_access_iterator I, typename Comp>
+    void sort(I first, I last, Comp comp) {
+        const int count = last - first;
+        if (count < 2) return;
+        detail::introsort_loop(first, last, detail::sort_depth_limit(count), comp);
+        detail::insertion_sort(first, last, comp);
+    }
+
     template<typename I>
     void sort(I first, I last) {
         sort(first, last, [](const auto& a, const auto& b){ return a < b; });
     }
+
+    // Stable merge sort, scratch must hold at least (last - first) / 2 elements
+    template<random_access_iterator I, typename T, typename Comp>
+    void stable_sort(I first, I last, T* scratch, Comp comp) {
+        detail::merge_sort(first, last, scratch, comp);
+    }
+
+    // Stable merge sort, allocates a temporary scratch buffer if needed
+    template<random_access_iterator I, typename Comp>
+    void stable_sort(I first, I last, Comp comp) {
+        using T = typename iterator_traits<I>::value_type;
+        const int count = last - first;
+        if (count <= detail::sort_threshold) {
+            detail::insertion_sort(first, last, comp);
+        } else {
+            T* scratch = new T[count / 2];
+            detail::merge_sort(first, last, scratch, comp);
+            delete[] scratch;
+        }
+    }
+
+    template<random_access_iterator I>
+    void stable_sort(I first, I last) {
+        stable_sort(first, last, [](const auto& a, const auto& b){ return a < b; });
+    }
+
+    // Stable LSD radix sort on a 16 bit key, scratch must hold at least (last - first) elements
+    template<random_access_iterator I, typename T, typename Key>
+    requires invocable_r<Key, uint16_t, const T&>
+    void radix_sort(I first, I last, T* scratch, Key key) {
+        const int count = last - first;
+        if (count < 2) return;
+        int offsets[2][256];
+        memset(offsets, 0, sizeof(offsets));
+        for (I it = first; it != last; ++it) {
+            const uint16_t k = key(*it);
+            offsets[0][k & 0xff]++;
+            offsets[1][k >> 8]++;
+        }
+        bool in_scratch = false;
+        for (int pass = 0; pass < 2; ++pass) {
+            auto& offset = offsets[pass];
+            const uint16_t k = key(in_scratch ? scratch[0] : first[0]);
+            if (offset[pass ? (k >> 8) : (k & 0xff)] == count) {
+                continue;  // All keys share this byte, nothing to do
+            }
+            int sum = 0;
+            for (int i = 0; i < 256; ++i) {
+                const int c = offset[i];
+                offset[i] = sum;
+                sum += c;
+            }
+            const int shift = pass * 8;
+            if (in_scratch) {
+                for (int i = 0; i < count; ++i) {
+                    first[offset[(key(scratch[i]) >> shift) & 0xff]++] = move(scratch[i]);
+                }
+            } else {
+                for (int i = 0; i < count; ++i) {
+                    scratch[offset[(key(first[i]) >> shift) & 0xff]++] = move(first[i]);
+                }
+            }
+            in_scratch = !in_scratch;
+        }
+        if (in_scratch) {
+            move(scratch, scratch + count, first);
+        }
+    }
+
+    // Partial sort so nth is the element that would be there if sorted, smaller before and larger after
+    template<random_access_iterator I, typename Comp>
+    void nth_element(I first, I nth, I last, Comp comp) {
+        if (first == last || nth == last) return;
+        int depth = detail::sort_depth_limit(last - first);
+        while (last - first > 3) {
+            if (depth == 0) {
+                detail::heap_sort(first, last, comp);
+                return;
+            }
+            --depth;
+            I cut = detail::partition_pivot(first, last, comp);
+            if (cut <= nth) {
+                first = cut;
+            } else {
+                last = cut;
+            }
+        }
+        detail::insertion_sort(first, last, comp);
+    }
+
+    template<random_access_iterator I>
+    void nth_element(I first, I nth, I last) {
+        nth_element(first, nth, last, [](const auto& a, const auto& b){ return a < b; });
+    }
+
+    // Reorders so elements satisfying pred precede those that do not, returns first of second group
+    template<forward_iterator I, typename P>
+    I partition(I first, I last, P pred) {
+        while (first != last && pred(*first)) {
+            ++first;
+        }
+        if (first == last) return first;
+        for (I it = first; ++it != last; ) {
+            if (pred(*it)) {
+                swap(*it, *first);
+                ++first;
+            }
+        }
+        return first;
+    }
     
     template<const_forward_iterator I, typename Comp>
     I is_sorted_until(I first, I last, Comp comp) {
@@ -18,6 +18,8 @@ namespace toybox {
         template<class Type, int Count>
         class base_buffer_static_c {
         protected:
+            static constexpr bool __is_growable = false;
+
             // Storage interface for vector_c
             __forceinline aligned_membuf_s<Type>* __buffer() __pure {
                 return _buffer;
@@ -43,6 +45,8 @@ namespace toybox {
         template<class Type>
         class base_buffer_dynamic_c {
         protected:
+            static constexpr bool __is_growable = true;
+
             ~base_buffer_dynamic_c() {
                 if (_buffer) delete[] _buffer;
             }
@@ -74,8 +78,7 @@ namespace toybox {
                     Type* src_first = _buffer[0].template ptr<0>();
                     Type* src_last = _buffer[current_size].template ptr<0>();
                     Type* dst_first = new_buffer[0].template ptr<0>();
-                    uninitialized_move(src_first, src_last, dst_first);
-                    destroy(src_first, src_last);
+                    uninitialized_relocate(src_first, src_last, dst_first);
                 }
 
                 if (_buffer) delete[] _buffer;
@@ -84,7 +87,8 @@ namespace toybox {
             }
 
             /// Transfer ownership from another base_vector_dynamic_c (for move operations)
-            __forceinline void __take_ownership(base_buffer_dynamic_c& o) {
+            __forceinline void __take_ownership(base_buffer_dynamic_c& o, int current_size) {
+                (void)current_size;  // Unused for dynamic storage
                 _buffer = o._buffer;
                 _capacity = o._capacity;
                 o._buffer = nullptr;
@@ -103,6 +107,85 @@ namespace toybox {
             int _capacity = 0;
         };
 
+        /**
+         Small storage base class for small_vector_c.
+         Provides Count inline elements, and spills to growable heap-allocated
+         storage when more are needed. Never shrinks back to inline storage.
+         The buffer pointer refers to the inline storage when not spilled, so
+         element access does not branch, but the storage must only be moved
+         using __take_ownership.
+         */
+        template<class Type, int Count>
+        class base_buffer_small_c {
+            static_assert(Count > 0, "Small storage requires inline capacity");
+        protected:
+            static constexpr bool __is_growable = true;
+
+            base_buffer_small_c() : _buffer(_inline), _capacity(Count) {}
+            ~base_buffer_small_c() {
+                if (_buffer != _inline) delete[] _buffer;
+            }
+
+            // Storage interface for vector_c
+            __forceinline aligned_membuf_s<Type>* __buffer() __pure {
+                return _buffer;
+            }
+            __forceinline const aligned_membuf_s<Type>* __buffer() const __pure {
+                return _buffer;
+            }
+            __forceinline int __capacity() const __pure {
+                return _capacity;
+            }
+
+            void __ensure_capacity(int needed, int current_size) {
+                if (needed <= _capacity) return;
+                int new_cap = _capacity * 2;
+                if (new_cap < needed) new_cap = needed;
+                auto* new_buffer = new aligned_membuf_s<Type>[new_cap];
+
+                // Move existing constructed elements to new buffer
+                if (current_size > 0) {
+                    Type* src_first = _buffer[0].template ptr<0>();
+                    Type* src_last = _buffer[current_size].template ptr<0>();
+                    Type* dst_first = new_buffer[0].template ptr<0>();
+                    uninitialized_relocate(src_first, src_last, dst_first);
+                }
+
+                if (_buffer != _inline) delete[] _buffer;
+                _buffer = new_buffer;
+                _capacity = new_cap;
+            }
+
+            /// Transfer ownership from another base_buffer_small_c (for move operations)
+            /// Inline elements can not be stolen, and are moved one by one.
+            void __take_ownership(base_buffer_small_c& o, int current_size) {
+                if (o._buffer == o._inline) {
+                    Type* src_first = o._inline[0].template ptr<0>();
+                    Type* src_last = o._inline[current_size].template ptr<0>();
+                    uninitialized_relocate(src_first, src_last, _inline[0].template ptr<0>());
+                    _buffer = _inline;
+                    _capacity = Count;
+                } else {
+                    _buffer = o._buffer;
+                    _capacity = o._capacity;
+                    o._buffer = o._inline;
+                    o._capacity = Count;
+                }
+            }
+
+            /// Release ownership without destroying (for move operations)
+            __forceinline void __release_ownership() {
+                if (_buffer != _inline) delete[] _buffer;
+                _buffer = _inline;
+                _capacity = Count;
+            }
+
+        private:
+            aligned_membuf_s<Type>* _buffer;
+            int _capacity;
+            aligned_membuf_s<Type> _inline[Count];
+        };
+
     } // namespace detail
     
 }
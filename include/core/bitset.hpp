@@ -10,7 +10,96 @@
 #include "core/concepts.hpp"
 
 namespace toybox {
-    
+
+    namespace detail {
+        // Trailing zero count per byte, 8 for zero.
+        struct ctz_table_s {
+            uint8_t values[256];
+            constexpr ctz_table_s() : values() {
+                values[0] = 8;
+                for (int i = 1; i < 256; ++i) {
+                    int n = 0;
+                    while (((i >> n) & 1) == 0) ++n;
+                    values[i] = n;
+                }
+            }
+        };
+        inline constexpr ctz_table_s ctz_table;
+        // Set bit count per byte.
+        struct popcount_table_s {
+            uint8_t values[256];
+            constexpr popcount_table_s() : values() {
+                for (int i = 1; i < 256; ++i) {
+                    values[i] = (i & 1) + values[i >> 1];
+                }
+            }
+        };
+        inline constexpr popcount_table_s popcount_table;
+        // Leading zero count per byte, 8 for zero.
+        struct clz_table_s {
+            uint8_t values[256];
+            constexpr clz_table_s() : values() {
+                values[0] = 8;
+                for (int i = 1; i < 256; ++i) {
+                    int n = 0;
+                    while (((i << n) & 0x80) == 0) ++n;
+                    values[i] = n;
+                }
+            }
+        };
+        inline constexpr clz_table_s clz_table;
+    }
+
+    /**
+     Returns the number of trailing zero bits, 32 if value is zero.
+     The 68000 has no bit scan instruction, so a byte table is used.
+     */
+    __forceinline constexpr int countr_zero(uint32_t value) {
+#ifdef __M68000__
+        int n = 0;
+        if ((value & 0xffff) == 0) {
+            if (value == 0) return 32;
+            value >>= 16; n = 16;
+        }
+        if ((value & 0xff) == 0) {
+            value >>= 8; n += 8;
+        }
+        return n + detail::ctz_table.values[value & 0xff];
+#else
+        return value == 0 ? 32 : __builtin_ctz(value);
+#endif
+    }
+
+    /**
+     Returns the number of leading zero bits, 32 if value is zero.
+     The 68000 has no bit scan instruction, so a byte table is used.
+     */
+    __forceinline constexpr int countl_zero(uint32_t value) {
+#ifdef __M68000__
+        int n = 0;
+        if ((value >> 16) == 0) {
+            if (value == 0) return 32;
+            value <<= 16; n = 16;
+        }
+        if ((value >> 24) == 0) {
+            value <<= 8; n += 8;
+        }
+        return n + detail::clz_table.values[value >> 24];
+#else
+        return value == 0 ? 32 : __builtin_clz(value);
+#endif
+    }
+
+    /// Returns the number of set bits.
+    __forceinline constexpr int popcount(uint32_t value) {
+#ifdef __M68000__
+        return detail::popcount_table.values[value & 0xff] + detail::popcount_table.values[(value >> 8) & 0xff] +
+               detail::popcount_table.values[(value >> 16) & 0xff] + detail::popcount_table.values[value >> 24];
+#else
+        return __builtin_popcount(value);
+#endif
+    }
+
     template<integral Int>
     class bitset_c {
         friend class reference_c;
@@ -65,9 +154,9 @@ namespace toybox {
                 next_set_bit();
             }
             constexpr void next_set_bit() {
-                while (_bit < end_bit && !_bitset[_bit]) {
-                    ++_bit;
-                }
+                if (_bit >= end_bit) return;
+                const uint32_t rest = (static_cast<uint32_t>(_bitset._raw) & all_bits) >> _bit;
+                _bit = rest ? _bit + countr_zero(rest) : end_bit;
             }
             const bitset_c& _bitset;
             int _bit;
@@ -90,6 +179,7 @@ namespace toybox {
         constexpr const reference_c operator[](int bit) const { return reference_c(const_cast<bitset_c&>(*this), bit); }
 
         constexpr operator bool() const { return _raw != 0; }
+        constexpr int count() const { return popcount(static_cast<uint32_t>(_raw) & all_bits); }
         constexpr bool operator==(const bitset_c& o) const { return _raw == o._raw; }
         constexpr bool operator==(const int bit) const { return (*this)[bit]; }
 
@@ -107,6 +197,7 @@ namespace toybox {
         constexpr const iterator_c end() const { return iterator_c(*this, end_bit); }
 
     private:
+        static constexpr uint32_t all_bits = end_bit == 32 ? 0xffffffff : ((uint32_t(1) << end_bit) - 1);
         struct tag_s{};
         constexpr bitset_c(Int raw, tag_s tag) : _raw(raw) {}
 #ifdef TOYBOX_HOST
@@ -116,5 +207,121 @@ namespace toybox {
 #endif
         Int _raw = 0;
     };
-    
+
+    /**
+     A fixed size set of Count bits, stored in 32 bit words.
+     Find and iteration skips whole empty words, and uses `countr_zero`
+     within words, never testing bits one by one.
+     */
+    template<int Count>
+    class bitset_array_c {
+    public:
+        static constexpr int bit_count = Count;
+        static constexpr int word_count = (Count + 31) / 32;
+
+        class iterator_c {
+            friend class bitset_array_c;
+        public:
+            __forceinline iterator_c& operator++() {
+                _bit = _bitset.find_next(_bit);
+                return *this;
+            }
+            __forceinline iterator_c operator++(int) {
+                iterator_c tmp = *this;
+                ++(*this);
+                return tmp;
+            }
+            __forceinline int operator*() const { return _bit; }
+            __forceinline bool operator==(const iterator_c& other) const {
+                return _bit == other._bit && &_bitset == &other._bitset;
+            }
+        private:
+            iterator_c(const bitset_array_c& bs, int bit) : _bitset(bs), _bit(bit) {}
+            const bitset_array_c& _bitset;
+            int _bit;
+        };
+
+        constexpr bitset_array_c() : _words() {}
+
+        __forceinline bool operator[](int bit) const { return test(bit); }
+        __forceinline bool test(int bit) const {
+            assert(bit >= 0 && bit < Count);
+            return (_words[bit >> 5] & bit_mask(bit)) != 0;
+        }
+        __forceinline void set(int bit) {
+            assert(bit >= 0 && bit < Count);
+            _words[bit >> 5] |= bit_mask(bit);
+        }
+        __forceinline void set(int bit, bool value) {
+            if (value) set(bit); else reset(bit);
+        }
+        __forceinline void reset(int bit) {
+            assert(bit >= 0 && bit < Count);
+            _words[bit >> 5] &= ~bit_mask(bit);
+        }
+        void clear() {
+            for (auto& word : _words) word = 0;
+        }
+
+        bool any() const {
+            for (const auto word : _words) {
+                if (word) return true;
+            }
+            return false;
+        }
+        __forceinline bool none() const { return !any(); }
+        int count() const {
+            int n = 0;
+            for (const auto word : _words) {
+                n += popcount(word);
+            }
+            return n;
+        }
+
+        /// Returns first set bit, or Count if no bit is set.
+        int find_first() const {
+            return find_from(0);
+        }
+        /// Returns first set bit after bit, or Count if no following bit is set.
+        int find_next(int bit) const {
+            return find_from(bit + 1);
+        }
+
+        bitset_array_c& operator+=(const bitset_array_c& o) {
+            for (int i = 0; i < word_count; ++i) _words[i] |= o._words[i];
+            return *this;
+        }
+        bitset_array_c& operator-=(const bitset_array_c& o) {
+            for (int i = 0; i < word_count; ++i) _words[i] &= ~o._words[i];
+            return *this;
+        }
+        bitset_array_c& operator&=(const bitset_array_c& o) {
+            for (int i = 0; i < word_count; ++i) _words[i] &= o._words[i];
+            return *this;
+        }
+        bool operator==(const bitset_array_c& o) const {
+            for (int i = 0; i < word_count; ++i) {
+                if (_words[i] != o._words[i]) return false;
+            }
+            return true;
+        }
+
+        __forceinline iterator_c begin() const { return iterator_c(*this, find_first()); }
+        __forceinline iterator_c end() const { return iterator_c(*this, Count); }
+
+    private:
+        static __forceinline uint32_t bit_mask(int bit) { return uint32_t(1) << (bit & 31); }
+        int find_from(int bit) const {
+            if (bit >= Count) return Count;
+            int idx = bit >> 5;
+            uint32_t word = _words[idx] & (0xffffffff << (bit & 31));
+            while (word == 0) {
+                if (++idx == word_count) return Count;
+                word = _words[idx];
+            }
+            return (idx << 5) + countr_zero(word);
+        }
+        uint32_t _words[word_count];
+    };
+
 }
@@ -0,0 +1,119 @@
+//
+//  codec.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/stream.hpp"
+
+namespace toybox {
+
+    namespace detail {
+
+        /**
+         `codec_stream_c` is the shared base of read only decompressing streams.
+         Compressed input is read ahead from the wrapped stream in blocks of
+         `sizeof(_in)`, so the wrapped stream may be positioned past the end of
+         the compressed data. Seeking forward decodes into a scratch buffer.
+         */
+        class codec_stream_c : public stream_c {
+        public:
+            virtual ~codec_stream_c() {}
+
+            using stream_c::write;
+            virtual size_t write(const uint8_t* buf, size_t count = 1) override;
+
+        protected:
+            codec_stream_c(stream_c& stream) : stream_c(), _stream(stream), _in_ptr(_in), _in_end(_in) {}
+
+            __forceinline void reset_input() { _in_ptr = _in_end = _in; }
+            bool refill();
+            __forceinline bool get_byte(uint8_t& byte) {
+                if (_in_ptr == _in_end && !refill()) {
+                    return false;
+                }
+                byte = *_in_ptr++;
+                return true;
+            }
+            /// Decodes and drops count bytes, returns false if the stream ends first.
+            bool skip(size_t count);
+
+            stream_c& _stream;  // Non-owning, caller must ensure lifetime
+            uint8_t _in[256];
+            const uint8_t* _in_ptr;
+            const uint8_t* _in_end;
+        };
+
+#ifndef __M68000__
+        /**
+         `byte_writer_c` buffers the output of the host encoders, and keeps
+         count of the bytes written and any failed write.
+         */
+        class byte_writer_c {
+        public:
+            byte_writer_c(stream_c& stream) : _stream(stream), _used(0), _written(0), _failed(false) {}
+
+            __forceinline void put_byte(uint8_t byte) {
+                _buffer[_used++] = byte;
+                if (_used == sizeof(_buffer)) {
+                    flush();
+                }
+            }
+            void put_bytes(const uint8_t* buf, size_t count);
+            /// Flushes the buffer, returns the bytes written, or 0 on failure.
+            size_t finish();
+
+        private:
+            void flush();
+            stream_c& _stream;
+            uint8_t _buffer[256];
+            size_t _used;
+            size_t _written;
+            bool _failed;
+        };
+
+        /**
+         `lz_matcher_c` finds the longest earlier match at a position with
+         hash chains, for the host encoders. Positions must be searched in
+         increasing order, all positions before the searched one are hashed
+         on the way.
+         */
+        class lz_matcher_c {
+        public:
+            lz_matcher_c(const uint8_t* data, size_t len, int window_bits, int32_t max_dist, int min_match, int32_t max_match, int max_chain);
+            ~lz_matcher_c();
+
+            __forceinline bool good() const __pure { return _head && _prev; }
+
+            /// Length of the longest match at pos, or 0 if shorter than the minimum.
+            int32_t find(int32_t pos, int32_t& dist);
+
+        private:
+            static constexpr int hash_bits = 15;
+            __forceinline int hash_at(const uint8_t* p) const {
+                uint32_t v = 0;
+                for (int i = 0; i < _min_match; ++i) {
+                    v = (v << 8) | p[i];
+                }
+                return static_cast<int>((v * 2654435761u) >> (32 - hash_bits));
+            }
+
+            const uint8_t* _data;
+            int32_t _end;
+            int32_t _window_mask;
+            int32_t _max_dist;
+            int32_t _max_match;
+            int _min_match;
+            int _max_chain;
+            int32_t _hashed;
+            int32_t* _head;
+            int32_t* _prev;
+        };
+#endif
+
+    }
+
+}
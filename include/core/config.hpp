@@ -26,6 +26,42 @@
 #   define TOYBOX_LOG_MALLOC 0
 #endif
 
+// Global operator new uses slab_allocator_c for small sizes.
+// Disabled for address sanitizer builds, as slabs hide heap errors.
+#ifndef TOYBOX_SLAB_ALLOCATOR
+#   if defined(__SANITIZE_ADDRESS__)
+#       define TOYBOX_SLAB_ALLOCATOR 0
+#   elif defined(__has_feature)
+#       if __has_feature(address_sanitizer)
+#           define TOYBOX_SLAB_ALLOCATOR 0
+#       endif
+#   endif
+#   ifndef TOYBOX_SLAB_ALLOCATOR
+#       define TOYBOX_SLAB_ALLOCATOR 1
+#   endif
+#endif
+
+#ifndef TOYBOX_SLAB_CHUNK_SIZE
+#   define TOYBOX_SLAB_CHUNK_SIZE 2048
+#endif
+
+#ifndef TOYBOX_SLAB_MAX_CHUNKS
+#   define TOYBOX_SLAB_MAX_CHUNKS 128
+#endif
+
+// Track global and pool allocations, host only as telemetry is slow.
+#ifndef TOYBOX_MEMORY_TELEMETRY
+#   ifdef TOYBOX_HOST
+#       define TOYBOX_MEMORY_TELEMETRY 1
+#   else
+#       define TOYBOX_MEMORY_TELEMETRY 0
+#   endif
+#endif
+
+#ifndef TOYBOX_FRAME_ARENA_SIZE
+#   define TOYBOX_FRAME_ARENA_SIZE 8192
+#endif
+
 #ifndef TOYBOX_SCREEN_SIZE_MAX
 #   define TOYBOX_SCREEN_SIZE_MAX size_s(320, 200)
 #endif
@@ -34,6 +70,21 @@
 #   define TOYBOX_SCREEN_SIZE_DEFAULT size_s(320, 200)
 #endif
 
+// Load ILBM images with non-standard deflate compressed BODY chunks,
+// needs about 4 KB plus the deflate window while loading.
+#ifndef TOYBOX_ILBM_SUPPORTS_DEFLATE
+#   define TOYBOX_ILBM_SUPPORTS_DEFLATE 1
+#endif
+
+// Entity positions use 20:12 fix32_t instead of 12:4 fix16_t,
+// for levels larger than 2047 pixels on an axis.
+// Level files keep 24 byte fix16_t entity records, widened when loaded,
+// so positions in files are still limited to fix16_t range, and only
+// the first 8 bytes of entity data fit.
+#ifndef TOYBOX_ENTITY_FIX32
+#   define TOYBOX_ENTITY_FIX32 0
+#endif
+
 #ifndef TOYBOX_DEBUG_CPU
 #   define TOYBOX_DEBUG_CPU 0
 #endif
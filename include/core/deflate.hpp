@@ -0,0 +1,100 @@
+//
+//  deflate.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/codec.hpp"
+
+namespace toybox {
+
+    namespace detail {
+        /// Canonical Huffman decoding table, codes of up to 9 bits need a single lookup.
+        struct inflate_huffman_s {
+            static constexpr int fast_bits = 9;
+            static constexpr int max_symbols = 288;
+            bool build(const uint8_t* code_lengths, int count);
+            uint16_t fast[1 << fast_bits];  // (length << fast_bits) | symbol, or 0 for longer codes
+            uint16_t first_code[16];
+            uint16_t first_symbol[16];
+            uint32_t max_code[17];          // One past the last code of each length, shifted to 16 bits
+            uint8_t lengths[max_symbols];
+            uint16_t symbols[max_symbols];
+        };
+    }
+
+    /**
+     `inflate_stream_c` decompresses a zlib (RFC 1950) deflate stream as it is read.
+     Memory is bounded by the window size given in the zlib header, at most
+     32 KB, and allocated once together with the decoding tables.
+     A stream cut short is an error, bytes decoded before the input ran out
+     are still returned. The Adler-32 checksum is verified when a read
+     reaches the end of the stream.
+     Only reading and seeking forward is supported.
+     */
+    class inflate_stream_c final : public detail::codec_stream_c {
+    public:
+        inflate_stream_c(stream_c& stream);
+        virtual ~inflate_stream_c();
+
+        virtual bool good() const override __pure;
+        virtual ptrdiff_t tell() const override __pure;
+        virtual ptrdiff_t seek(ptrdiff_t pos, seekdir_e way) override;
+
+        using stream_c::read;
+        virtual size_t read(uint8_t* buf, size_t count = 1) override;
+
+    private:
+        enum class state_e : uint8_t {
+            header, block, stored, codes, done, error
+        };
+        struct tables_s {
+            detail::inflate_huffman_s litlen;
+            detail::inflate_huffman_s dist;
+        };
+
+        void fill_bits();
+        uint16_t get_bits(int count);
+        int16_t decode(const detail::inflate_huffman_s& huffman);
+        bool read_header();
+        bool read_block_header();
+        bool read_dynamic_tables();
+        bool read_trailer();
+        __forceinline void check_truncated() {
+            // Padding is always the topmost bits, consuming any is reading past the input.
+            if (_bit_count < _pad_bits) {
+                _truncated = true;
+            }
+        }
+
+        int16_t _pad_bits;  // Zero bits added past the end of input
+        uint32_t _bits;
+        int16_t _bit_count;
+        state_e _state;
+        bool _final;
+        bool _truncated;
+        tables_s* _tables;  // Window follows tables in the same allocation
+        uint8_t* _window;
+        uint16_t _window_mask;
+        uint16_t _window_pos;
+        uint16_t _stored_left;
+        uint16_t _match_left;
+        uint16_t _match_dist;
+        uint32_t _adler;    // Running Adler-32 of the output
+        size_t _pos;
+    };
+
+#ifndef __M68000__
+    /**
+     Compresses len bytes of data into stream as a zlib stream, using a
+     window of 1 << window_bits bytes. The window bounds the memory needed by
+     `inflate_stream_c` to decompress it. Host only.
+     Returns the number of bytes written, or 0 on failure.
+     */
+    size_t deflate(stream_c& stream, const uint8_t* data, size_t len, int window_bits = 12);
+#endif
+
+}
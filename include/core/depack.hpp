@@ -0,0 +1,79 @@
+//
+//  depack.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/codec.hpp"
+
+namespace toybox {
+
+    /**
+     `depack_stream_c` decompresses an LZ4 style stream as it is read.
+     Sequences are a token of literal and match lengths, the literals, and a
+     big endian 16 bit match offset. There is no entropy coding, so decoding
+     is mostly `memcpy`, fast enough on 68000 to outrun the floppy.
+     A read of the whole stream in one call decodes straight into the
+     destination, other reads go through a window of the size given in the
+     header, allocated on first use.
+     Only reading is supported. Seeking backward restarts decoding from the
+     start, and needs a seekable wrapped stream.
+     */
+    class depack_stream_c final : public detail::codec_stream_c {
+    public:
+        static constexpr size_t header_size = 12;
+
+        depack_stream_c(stream_c& stream);
+        depack_stream_c(const shared_ptr_c<stream_c>& stream);
+        virtual ~depack_stream_c();
+
+        /// Returns true if data starts with a packed stream header.
+        static bool is_packed(const uint8_t* data, size_t len);
+
+        /// Size of the unpacked data.
+        __forceinline size_t size() const __pure { return _size; }
+
+        virtual bool good() const override __pure;
+        virtual ptrdiff_t tell() const override __pure;
+        virtual ptrdiff_t seek(ptrdiff_t pos, seekdir_e way) override;
+
+        using stream_c::read;
+        virtual size_t read(uint8_t* buf, size_t count = 1) override;
+
+    private:
+        enum class state_e : uint8_t {
+            token, literals, offset, match, done, error
+        };
+
+        bool restart();
+        bool get_bytes(uint8_t* buf, size_t count);
+        bool get_length(size_t& length);
+        size_t read_direct(uint8_t* buf);
+        size_t read_window(uint8_t* buf, size_t count);
+
+        shared_ptr_c<stream_c> _owned;  // Keeps the wrapped stream alive, if given
+        ptrdiff_t _origin;
+        state_e _state;
+        uint8_t _window_bits;
+        uint8_t _match_nibble;
+        uint8_t* _window;
+        uint16_t _window_pos;
+        uint16_t _match_dist;
+        size_t _left;       // Literals or match bytes left in current sequence
+        size_t _size;
+        size_t _pos;
+    };
+
+#ifndef __M68000__
+    /**
+     Compresses len bytes of data into stream for `depack_stream_c`, with
+     match offsets limited to 1 << window_bits bytes. Host only.
+     Returns the number of bytes written, or 0 on failure.
+     */
+    size_t lz_compress(stream_c& stream, const uint8_t* data, size_t len, int window_bits = 12);
+#endif
+
+}
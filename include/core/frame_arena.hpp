@@ -0,0 +1,72 @@
+//
+//  frame_arena.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/utility.hpp"
+
+namespace toybox {
+
+/**
+ A `frame_arena_c` is a bump-pointer allocator for transient per-frame data.
+ Allocations are a pointer bump, there is no individual free, instead all
+ allocations are released at once by `reset()`.
+ The `scene_manager_c` resets the arena once per frame, so memory is valid
+ for the duration of `scene_c::update()` and `tilemap_level_c::update()`.
+ Destructors are never run, only trivially destructible types can be made.
+ Capacity is configured with `TOYBOX_FRAME_ARENA_SIZE`, the arena is a
+ fixed static block with no fallback so running out is a hard assert.
+ */
+class frame_arena_c {
+public:
+    static constexpr size_t capacity = TOYBOX_FRAME_ARENA_SIZE;
+    static constexpr size_t alignment = sizeof(void*);
+    static void* allocate(size_t size) {
+        size = (size + (alignment - 1)) & ~(alignment - 1);
+        hard_assert(_used + size <= capacity && "Frame arena exhausted");
+        void* ptr = &_buffer[_used];
+        _used += size;
+#ifndef __M68000__
+        _peak_used = MAX(_peak_used, _used);
+#endif
+        return ptr;
+    }
+    static void deallocate(void* ptr) {
+        // Released by reset(), present for pool_allocator_c compatibility.
+        assert(owns(ptr) && "Pointer not owned by frame arena");
+    }
+    template<class T, class... Args> requires is_trivially_destructible<T>::value
+    static T* make(Args&&... args) {
+        static_assert(alignof(T) <= alignment);
+        return construct_at(static_cast<T*>(allocate(sizeof(T))), forward<Args>(args)...);
+    }
+    template<class T> requires is_trivially_destructible<T>::value
+    static T* make_array(size_t count) {
+        static_assert(alignof(T) <= alignment);
+        T* ptr = static_cast<T*>(allocate(sizeof(T) * count));
+        for (size_t i = 0; i < count; ++i) {
+            construct_at(ptr + i);
+        }
+        return ptr;
+    }
+    static void reset() { _used = 0; }
+    static size_t used() { return _used; }
+    static bool owns(const void* ptr) {
+        return ptr >= &_buffer[0] && ptr < &_buffer[capacity];
+    }
+#ifndef __M68000__
+    static size_t peak_used() { return _peak_used; }
+#endif
+private:
+    alignas(alignment) static inline uint8_t _buffer[capacity];
+    static inline size_t _used = 0;
+#ifndef __M68000__
+    static inline size_t _peak_used = 0;
+#endif
+};
+
+}
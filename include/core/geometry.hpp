@@ -178,6 +178,7 @@ namespace toybox {
 
     using rect_s = base_rect_s<int16_t>;
     static_assert(sizeof(rect_s) == 8);
+    static_assert(is_trivially_relocatable<rect_s>::value);
 
 #pragma mark - Real geometry
 
@@ -189,6 +190,17 @@ namespace toybox {
 
     using frect_s = base_rect_s<fix16_t>;
     static_assert(sizeof(frect_s) == 8);
+    static_assert(is_trivially_relocatable<frect_s>::value);
+
+    using fpoint32_s = base_point_s<fix32_t>;
+    static_assert(sizeof(fpoint32_s) == 8);
+
+    using fsize32_s = base_size_s<fix32_t>;
+    static_assert(sizeof(fsize32_s) == 8);
+
+    using frect32_s = base_rect_s<fix32_t>;
+    static_assert(sizeof(frect32_s) == 16);
+    static_assert(is_trivially_relocatable<frect32_s>::value);
     
 }
 
@@ -0,0 +1,313 @@
+//
+//  hash_map.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/algorithm.hpp"
+#include "core/initializer_list.hpp"
+#include "core/base_buffer.hpp"
+#include "core/utility.hpp"
+
+namespace toybox {
+
+    /**
+     `hash_c` is the default hash for `hash_map_c`.
+     A hash provides a static `hash()` and `equal()` for a key type.
+     Integral, enum and pointer keys are mixed with shifts only, as 32 bit
+     multiplication is expensive on 68000.
+     */
+    template<class Key>
+    struct hash_c {
+        static constexpr size_t hash(const Key& key) {
+            uint32_t v;
+            if constexpr (is_pointer<Key>::value) {
+                v = static_cast<uint32_t>(reinterpret_cast<uintptr_t>(key) >> 2);
+            } else {
+                v = static_cast<uint32_t>(key);
+            }
+            v ^= v >> 16;
+            v ^= v >> 8;
+            return v;
+        }
+        static constexpr bool equal(const Key& a, const Key& b) {
+            return a == b;
+        }
+    };
+
+    /// String keys are hashed by content using djb2, and compared with `strcmp`.
+    template<>
+    struct hash_c<const char*> {
+        static size_t hash(const char* key) {
+            uint32_t v = 5381;
+            while (*key) {
+                v = (v << 5) + v + static_cast<uint8_t>(*key++);
+            }
+            return v ^ (v >> 16);
+        }
+        static bool equal(const char* a, const char* b) {
+            return strcmp(a, b) == 0;
+        }
+    };
+
+    namespace detail {
+        template<class Value>
+        struct hash_slot_s {
+            aligned_membuf_s<Value> storage;
+            bool occupied = false;
+        };
+    }
+
+    /**
+     `hash_map_c` is a minimal implementation of `std::unordered_map`.
+     Uses open addressing with linear probing, and a power of two capacity.
+     Erase shifts following entries back, so no tombstones are ever needed.
+     When Count > 0: Uses statically allocated backing store, Count must be a
+     power of two, and the map can hold at most Count - 1 elements.
+     When Count == 0: Uses dynamically allocated backing store, and rehashes
+     to double capacity when 3/4 full.
+     Iteration order is unspecified, and insert or erase invalidates iterators.
+     */
+    template<class Key, class Type, int Count, class Hash = hash_c<Key>>
+    class hash_map_c : public nocopy_c,
+                       private conditional<Count == 0,
+                                           detail::base_buffer_dynamic_c<detail::hash_slot_s<pair_c<Key,Type>>>,
+                                           detail::base_buffer_static_c<detail::hash_slot_s<pair_c<Key,Type>>, Count>>::type
+    {
+        static_assert(is_trivial<Key>::value);
+        static_assert((Count & (Count - 1)) == 0, "Count must be a power of two");
+        using slot_s = detail::hash_slot_s<pair_c<Key,Type>>;
+    public:
+        using key_type = Key;
+        using mapped_type = Type;
+        using value_type = pair_c<key_type,mapped_type>;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        template<class TypeI, class SlotI>
+        struct iterator_s {
+            using value_type = TypeI;
+            using pointer = value_type*;
+            using reference = value_type&;
+
+            iterator_s(SlotI* slot, SlotI* end) : _slot(slot), _end(end) { skip_empty(); }
+
+            __forceinline reference operator*() const { return *_slot->storage.template ptr<0>(); }
+            __forceinline pointer operator->() const { return _slot->storage.template ptr<0>(); }
+            __forceinline iterator_s& operator++() { ++_slot; skip_empty(); return *this; }
+            __forceinline iterator_s operator++(int) { auto tmp = *this; ++(*this); return tmp; }
+            __forceinline bool operator==(const iterator_s& o) const { return _slot == o._slot; }
+        private:
+            __forceinline void skip_empty() {
+                while (_slot != _end && !_slot->occupied) ++_slot;
+            }
+            SlotI* _slot;
+            SlotI* _end;
+        };
+        using iterator = iterator_s<value_type, slot_s>;
+        using const_iterator = iterator_s<const value_type, const slot_s>;
+
+        hash_map_c() : _size(0) {}
+        hash_map_c(initializer_list<value_type> init) : _size(0) {
+            for (const auto& value : init) {
+                insert(value);
+            }
+        }
+        hash_map_c(hash_map_c&& o) requires (Count == 0) : _size(o._size) {
+            this->__take_ownership(o, o._size);
+            o._size = 0;
+        }
+        ~hash_map_c() {
+            clear();
+        }
+
+        hash_map_c& operator=(hash_map_c&& o) requires (Count == 0) {
+            if (this == &o) return *this;
+            clear();
+            this->__release_ownership();
+            this->__take_ownership(o, o._size);
+            _size = o._size;
+            o._size = 0;
+            return *this;
+        }
+
+        __forceinline iterator begin() __pure {
+            return iterator(slots(), slots() + this->__capacity());
+        }
+        __forceinline const_iterator begin() const __pure {
+            return const_iterator(slots(), slots() + this->__capacity());
+        }
+        __forceinline iterator end() __pure {
+            return iterator(slots() + this->__capacity(), slots() + this->__capacity());
+        }
+        __forceinline const_iterator end() const __pure {
+            return const_iterator(slots() + this->__capacity(), slots() + this->__capacity());
+        }
+        __forceinline int size() const __pure { return _size; }
+        __forceinline int capacity() const __pure { return this->__capacity(); }
+
+        iterator find(const Key& key) {
+            const int idx = find_index(key);
+            return idx < 0 ? end() : iterator(slots() + idx, slots() + this->__capacity());
+        }
+        const_iterator find(const Key& key) const {
+            const int idx = find_index(key);
+            return idx < 0 ? end() : const_iterator(slots() + idx, slots() + this->__capacity());
+        }
+        __forceinline bool contains(const Key& key) const {
+            return find_index(key) >= 0;
+        }
+
+        __forceinline Type& operator[](const Key& key) __pure {
+            const int idx = find_index(key);
+            assert(idx >= 0 && "Key not found");
+            return slots()[idx].storage.template ptr<0>()->second;
+        }
+        __forceinline const Type& operator[](const Key& key) const __pure {
+            const int idx = find_index(key);
+            assert(idx >= 0 && "Key not found");
+            return slots()[idx].storage.template ptr<0>()->second;
+        }
+
+        /// Inserts value, replacing any existing value with the same key.
+        iterator insert(const_reference value) {
+            slot_s* slot = insert_slot(value.first);
+            construct_at(slot->storage.template ptr<0>(), value);
+            return iterator(slot, slots() + this->__capacity());
+        }
+
+        template<class... Args>
+        iterator emplace(const key_type& key, Args&&... args) {
+            slot_s* slot = insert_slot(key);
+            construct_at(slot->storage.template ptr<0>(), key, forward<Args>(args)...);
+            return iterator(slot, slots() + this->__capacity());
+        }
+
+        /// Erases value for key, returns false if key was not found.
+        bool erase(const key_type& key) {
+            int idx = find_index(key);
+            if (idx < 0) {
+                return false;
+            }
+            destroy_at(slots()[idx].storage.template ptr<0>());
+            slots()[idx].occupied = false;
+            _size--;
+            // Shift back following entries that would no longer be reachable.
+            const int mask = this->__capacity() - 1;
+            int next = idx;
+            while (true) {
+                next = (next + 1) & mask;
+                slot_s& slot = slots()[next];
+                if (!slot.occupied) {
+                    break;
+                }
+                const int home = static_cast<int>(Hash::hash(slot.storage.template ptr<0>()->first)) & mask;
+                if (((next - home) & mask) >= ((next - idx) & mask)) {
+                    relocate(slot, slots()[idx]);
+                    idx = next;
+                }
+            }
+            return true;
+        }
+
+        void clear() {
+            if (_size == 0) return;
+            for (int i = 0; i < this->__capacity(); ++i) {
+                slot_s& slot = slots()[i];
+                if (slot.occupied) {
+                    destroy_at(slot.storage.template ptr<0>());
+                    slot.occupied = false;
+                }
+            }
+            _size = 0;
+        }
+
+        void reserve(int new_size) requires (Count == 0) {
+            int new_cap = 8;
+            while (new_cap * 3 < new_size * 4) {
+                new_cap *= 2;
+            }
+            if (new_cap > this->__capacity()) {
+                rehash(new_cap);
+            }
+        }
+
+    private:
+        __forceinline slot_s* slots() __pure { return this->__buffer()[0].template ptr<0>(); }
+        __forceinline const slot_s* slots() const __pure { return this->__buffer()[0].template ptr<0>(); }
+
+        int find_index(const Key& key) const {
+            const int capacity = this->__capacity();
+            if (capacity == 0) return -1;
+            const int mask = capacity - 1;
+            int idx = static_cast<int>(Hash::hash(key)) & mask;
+            while (slots()[idx].occupied) {
+                if (Hash::equal(slots()[idx].storage.template ptr<0>()->first, key)) {
+                    return idx;
+                }
+                idx = (idx + 1) & mask;
+            }
+            return -1;
+        }
+
+        // Returns an unconstructed slot for key, destroying any existing value for key.
+        slot_s* insert_slot(const Key& key) {
+            if constexpr (Count == 0) {
+                if ((_size + 1) * 4 > this->__capacity() * 3) {
+                    rehash(this->__capacity() ? this->__capacity() * 2 : 8);
+                }
+            }
+            const int mask = this->__capacity() - 1;
+            int idx = static_cast<int>(Hash::hash(key)) & mask;
+            while (slots()[idx].occupied) {
+                slot_s& slot = slots()[idx];
+                if (Hash::equal(slot.storage.template ptr<0>()->first, key)) {
+                    destroy_at(slot.storage.template ptr<0>());
+                    return &slot;
+                }
+                idx = (idx + 1) & mask;
+            }
+            if constexpr (Count != 0) {
+                // Keep one slot free so probes for missing keys terminate.
+                assert(_size + 1 < Count && "Hash map capacity exceeded");
+            }
+            slots()[idx].occupied = true;
+            _size++;
+            return &slots()[idx];
+        }
+
+        static void relocate(slot_s& from, slot_s& to) {
+            construct_at(to.storage.template ptr<0>(), move(*from.storage.template ptr<0>()));
+            destroy_at(from.storage.template ptr<0>());
+            to.occupied = true;
+            from.occupied = false;
+        }
+
+        void rehash(int new_cap) requires (Count == 0) {
+            hash_map_c other;
+            other.__ensure_capacity(new_cap, 0);
+            const int mask = new_cap - 1;
+            for (int i = 0; i < this->__capacity(); ++i) {
+                slot_s& slot = slots()[i];
+                if (slot.occupied) {
+                    int idx = static_cast<int>(Hash::hash(slot.storage.template ptr<0>()->first)) & mask;
+                    while (other.slots()[idx].occupied) {
+                        idx = (idx + 1) & mask;
+                    }
+                    relocate(slot, other.slots()[idx]);
+                }
+            }
+            other._size = _size;
+            _size = 0;
+            *this = move(other);
+        }
+
+        int _size;
+    };
+
+}
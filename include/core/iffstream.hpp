@@ -9,6 +9,7 @@
 
 #include "core/stream.hpp"
 #include "core/utility.hpp"
+#include "core/vector.hpp"
 
 namespace toybox {
 
@@ -90,6 +91,10 @@ namespace toybox {
         inline static const constexpr unknown_writer null_writer{};
 
         iffstream_c(shared_ptr_c<stream_c> stream);
+        /**
+         Files opened for input are read whole into a `memstream_c`, or if too
+         large are buffered, and packed files unpacked as they are read.
+         */
         iffstream_c(const char* path, fstream_c::openmode_e mode = fstream_c::openmode_e::input);
         ~iffstream_c() = default;
                 
@@ -114,8 +119,8 @@ namespace toybox {
 
         using stream_c::write;
         virtual size_t write(const uint8_t* buf, size_t count = 1) override;
+        virtual const uint8_t* view(size_t count) override;
 
-        
 #ifndef __M68000__
         template<typename T> requires (!same_as<T, uint8_t>)
         size_t read(T* buf, size_t count = 1) {
@@ -141,5 +146,48 @@ namespace toybox {
 
         shared_ptr_c<stream_c> _stream;
     };
-        
+
+    /**
+     An `iff_index_c` is a directory of every chunk in an IFF file.
+     Chunk headers are scanned once, recursing into nested FORM, LIST and
+     CAT groups, recording id, offset, size and group subtype. Lookup and
+     iteration by id then need no reads or seeks, `iffstream_c::reset()`
+     positions the stream at the data of a found chunk.
+     Entries are stored in file order, a group is followed by its children.
+     */
+    class iff_index_c : public nocopy_c {
+    public:
+        struct entry_s : public iff_group_s {
+            int16_t parent; // Index of enclosing group, -1 for the top chunk
+            int16_t end;    // Index past the last child, or past self if not a group
+        };
+        using const_iterator = const entry_s*;
+
+        iff_index_c(iffstream_c& file);
+        ~iff_index_c() = default;
+
+        __forceinline bool good() const __pure { return _entries.size() > 0; }
+        __forceinline int size() const __pure { return _entries.size(); }
+        __forceinline const_iterator begin() const __pure { return _entries.begin(); }
+        __forceinline const_iterator end() const __pure { return _entries.end(); }
+        __forceinline const entry_s& operator[](int index) const __pure { return _entries[index]; }
+
+        /// Returns the top chunk if it matches id and subtype, or nullptr.
+        const entry_s* first(cc4_t id, cc4_t subtype = cc4::ANY) const;
+        /// Returns the first direct child of group matching id, or nullptr.
+        const entry_s* first(const entry_s& group, cc4_t id) const;
+        /// Returns the next sibling after chunk matching id, or nullptr.
+        const entry_s* next(const entry_s& chunk, cc4_t id) const;
+        /// Returns the first chunk matching id at any depth, or nullptr.
+        const entry_s* find(cc4_t id) const;
+
+        static bool is_group(cc4_t id) { return id == cc4::FORM || id == cc4::LIST || id == cc4::CAT; }
+
+    private:
+        const entry_s* find_sibling(int index, int end, cc4_t id) const;
+        bool scan(iffstream_c& file, const iff_chunk_s& chunk, int parent);
+
+        vector_c<entry_s, 0> _entries;
+    };
+
 }
@@ -0,0 +1,136 @@
+//
+//  inplace_function.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/utility.hpp"
+
+namespace toybox {
+
+    template<typename Signature, size_t Size = sizeof(void*) * 3>
+    class inplace_function_c;
+
+    /**
+     `inplace_function_c` is an owning type erased callable, similar to
+     `std::function` but never allocates. The callable is stored inline in a
+     buffer of Size bytes, a callable that does not fit is a compile error.
+     Unlike `function_c` captured state is owned, so lambdas do not need to
+     outlive the function. Invocation is a single indirect call, copy and
+     destruction of trivial callables need no indirect call at all.
+     */
+    template<typename R, typename... Args, size_t Size>
+    class inplace_function_c<R(Args...), Size> {
+    public:
+        static constexpr size_t capacity = Size;
+
+        inplace_function_c() : _invoker(nullptr), _manager(nullptr) {}
+        inplace_function_c(nullptr_t) : inplace_function_c() {}
+        inplace_function_c(R(*func)(Args...)) : inplace_function_c() {
+            if (func) {
+                emplace<R(*)(Args...)>(func);
+            }
+        }
+        template<typename F>
+        requires (!same_as<typename remove_cvref<F>::type, inplace_function_c> && invocable<F&, Args...>)
+        inplace_function_c(F&& func) : inplace_function_c() {
+            emplace<typename remove_cvref<F>::type>(forward<F>(func));
+        }
+        inplace_function_c(const inplace_function_c& o) : _invoker(o._invoker), _manager(o._manager) {
+            if (_manager) {
+                _manager(copy_op, _storage, const_cast<uint8_t*>(o._storage));
+            } else {
+                memcpy(_storage, o._storage, Size);
+            }
+        }
+        inplace_function_c(inplace_function_c&& o) : _invoker(o._invoker), _manager(o._manager) {
+            if (_manager) {
+                _manager(move_op, _storage, o._storage);
+            } else {
+                memcpy(_storage, o._storage, Size);
+            }
+        }
+        ~inplace_function_c() { reset(); }
+
+        inplace_function_c& operator=(const inplace_function_c& o) {
+            if (this != &o) {
+                this->~inplace_function_c();
+                new (static_cast<void*>(this)) inplace_function_c(o);
+            }
+            return *this;
+        }
+        inplace_function_c& operator=(inplace_function_c&& o) {
+            if (this != &o) {
+                this->~inplace_function_c();
+                new (static_cast<void*>(this)) inplace_function_c(move(o));
+            }
+            return *this;
+        }
+        inplace_function_c& operator=(nullptr_t) {
+            reset();
+            return *this;
+        }
+
+        __forceinline R operator()(Args... args) const {
+            assert(_invoker && "Calling empty inplace_function_c");
+            return _invoker(const_cast<uint8_t*>(_storage), static_cast<Args&&>(args)...);
+        }
+
+        __forceinline explicit operator bool() const { return _invoker != nullptr; }
+
+        void reset() {
+            if (_manager) {
+                _manager(destroy_op, _storage, nullptr);
+            }
+            _invoker = nullptr;
+            _manager = nullptr;
+        }
+
+    private:
+        enum manage_op_e : uint8_t {
+            copy_op, move_op, destroy_op
+        };
+        using invoke_ptr_t = R(*)(void*, Args...);
+        using manage_ptr_t = void(*)(manage_op_e, void*, void*);
+
+        template<typename F, typename A>
+        void emplace(A&& func) {
+            static_assert(sizeof(F) <= Size, "Callable too large for inplace_function_c, increase Size");
+            static_assert(alignof(F) <= alignof(max_align_t), "Callable alignment too large for inplace_function_c");
+            new (static_cast<void*>(_storage)) F(forward<A>(func));
+            _invoker = invoke<F>;
+            if constexpr (is_trivially_copyable<F>::value && is_trivially_destructible<F>::value) {
+                _manager = nullptr;
+            } else {
+                _manager = manage<F>;
+            }
+        }
+        template<typename F>
+        static R invoke(void* obj, Args... args) {
+            auto& func = *static_cast<F*>(obj);
+            return func(static_cast<Args&&>(args)...);
+        }
+        template<typename F>
+        static void manage(manage_op_e op, void* dst, void* src) {
+            switch (op) {
+                case copy_op:
+                    new (dst) F(*static_cast<const F*>(src));
+                    break;
+                case move_op:
+                    new (dst) F(move(*static_cast<F*>(src)));
+                    break;
+                case destroy_op:
+                    destroy_at(static_cast<F*>(dst));
+                    break;
+            }
+        }
+
+        alignas(max_align_t) uint8_t _storage[Size];
+        invoke_ptr_t _invoker;
+        manage_ptr_t _manager;
+    };
+
+}
@@ -0,0 +1,172 @@
+//
+//  intrusive_list.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/utility.hpp"
+
+namespace toybox {
+
+    /**
+     Link storage for elements of an `intrusive_list_c`.
+     Element types inherit publicly from `intrusive_list_node_s<Type>`.
+     Links are never copied, a copied element is always unlinked.
+     */
+    template<class Type>
+    struct intrusive_list_node_s {
+        intrusive_list_node_s() = default;
+        intrusive_list_node_s(const intrusive_list_node_s&) {}
+        intrusive_list_node_s& operator=(const intrusive_list_node_s&) { return *this; }
+        Type* next = nullptr;
+        Type* prev = nullptr;
+    };
+
+    /**
+     A doubly-linked list where elements embed their own links.
+     Similar to `boost::intrusive::list`, the list never allocates, copies or
+     destroys elements, ownership of elements is left to the caller.
+     Unlink, size and splicing are all O(1) operations.
+     The head pointer is the first member of the list, and `next` the first
+     member of a node, so that assembly can walk the list with a single loop.
+     */
+    template<class Type>
+    class intrusive_list_c : public nocopy_c {
+    public:
+        using value_type = Type;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        template<class TypeI>
+        struct iterator_s {
+            using value_type = TypeI;
+            using pointer = value_type*;
+            using reference = value_type&;
+
+            iterator_s() = delete;
+            iterator_s(const iterator_s& o) = default;
+            iterator_s(TypeI* node) : _node(node) {}
+            iterator_s(const iterator_s<Type>& other) requires (!same_as<Type, TypeI>) : _node(other._node) {}
+
+            __forceinline reference operator*() const { return *_node; }
+            __forceinline pointer operator->() const { return _node; }
+            __forceinline iterator_s& operator++() { _node = _node->next; return *this; }
+            __forceinline iterator_s operator++(int) { auto tmp = *this; _node = _node->next; return tmp; }
+            __forceinline bool operator==(const iterator_s& o) const { return _node == o._node; }
+
+            TypeI* _node;
+        };
+        using iterator = iterator_s<Type>;
+        using const_iterator = iterator_s<const Type>;
+
+        intrusive_list_c() : _head(nullptr), _tail(nullptr), _size(0) {}
+        ~intrusive_list_c() = default;
+
+        __forceinline bool empty() const __pure { return _head == nullptr; }
+        __forceinline int size() const __pure { return _size; }
+
+        __forceinline iterator begin() __pure { return iterator(_head); }
+        __forceinline const_iterator begin() const __pure { return const_iterator(_head); }
+        __forceinline iterator end() __pure { return iterator(nullptr); }
+        __forceinline const_iterator end() const __pure { return const_iterator(nullptr); }
+
+        __forceinline reference front() __pure {
+            assert(_head && "List is empty");
+            return *_head;
+        }
+        __forceinline const_reference front() const __pure {
+            assert(_head && "List is empty");
+            return *_head;
+        }
+        __forceinline reference back() __pure {
+            assert(_tail && "List is empty");
+            return *_tail;
+        }
+        __forceinline const_reference back() const __pure {
+            assert(_tail && "List is empty");
+            return *_tail;
+        }
+
+        __forceinline void push_front(reference value) {
+            insert(begin(), value);
+        }
+        __forceinline void push_back(reference value) {
+            insert(end(), value);
+        }
+        /// Links value before pos, value must not be linked in any list.
+        iterator insert(const_iterator pos, reference value) {
+            assert(value.next == nullptr && value.prev == nullptr && &value != _head && "Element already linked");
+            Type* next = const_cast<Type*>(pos._node);
+            Type* prev = next ? next->prev : _tail;
+            link(&value, prev, next);
+            _size++;
+            return iterator(&value);
+        }
+
+        __forceinline void pop_front() {
+            erase(front());
+        }
+        __forceinline void pop_back() {
+            erase(back());
+        }
+        /// Unlinks value from this list, returns iterator to the following element.
+        iterator erase(reference value) {
+            assert(_size > 0 && "List is empty");
+            Type* next = value.next;
+            unlink(&value);
+            _size--;
+            return iterator(next);
+        }
+        __forceinline iterator erase(const_iterator pos) {
+            return erase(*const_cast<Type*>(pos._node));
+        }
+        /// Unlinks all elements, elements are not destroyed.
+        void clear() {
+            while (_head) {
+                pop_front();
+            }
+        }
+
+        /// Moves value from `other` to before `pos` in this list.
+        void splice(const_iterator pos, intrusive_list_c& other, reference value) {
+            other.erase(value);
+            insert(pos, value);
+        }
+        /// Moves all elements from `other` to before `pos` in this list.
+        void splice(const_iterator pos, intrusive_list_c& other) {
+            if (this == &other || other._head == nullptr) return;
+            Type* next = const_cast<Type*>(pos._node);
+            Type* prev = next ? next->prev : _tail;
+            other._head->prev = prev;
+            other._tail->next = next;
+            if (prev) prev->next = other._head; else _head = other._head;
+            if (next) next->prev = other._tail; else _tail = other._tail;
+            _size += other._size;
+            other._head = other._tail = nullptr;
+            other._size = 0;
+        }
+
+    private:
+        void link(Type* value, Type* prev, Type* next) {
+            value->prev = prev;
+            value->next = next;
+            if (prev) prev->next = value; else _head = value;
+            if (next) next->prev = value; else _tail = value;
+        }
+        void unlink(Type* value) {
+            if (value->prev) value->prev->next = value->next; else _head = value->next;
+            if (value->next) value->next->prev = value->prev; else _tail = value->prev;
+            value->next = nullptr;
+            value->prev = nullptr;
+        }
+        Type* _head;
+        Type* _tail;
+        int _size;
+    };
+
+}
@@ -51,7 +51,7 @@ namespace toybox {
             _size = o._size;
         }
         constexpr map_c(map_c&& o) requires (Count == 0) : _size(o._size) {
-            this->__take_ownership(o);
+            this->__take_ownership(o, o._size);
             o._size = 0;
         }
                                             
@@ -72,7 +72,7 @@ namespace toybox {
             if (this == &o) return *this;
             clear();
             this->__release_ownership();
-            this->__take_ownership(o);
+            this->__take_ownership(o, o._size);
             _size = o._size;
             o._size = 0;
             return *this;
@@ -170,9 +170,14 @@ namespace toybox {
         iterator erase(const_iterator pos) {
             assert(_size > 0 && "Map is empty");
             assert(pos >= begin() && pos < end() && "Invalid erase position");
-            destroy_at(pos);
             iterator ins = (iterator)pos;
-            move((iterator)pos + 1, end(), ins);
+            if constexpr (is_trivially_relocatable<value_type>::value) {
+                destroy_at(ins);
+                memmove(static_cast<void*>(ins), static_cast<const void*>(ins + 1), (end() - ins - 1) * sizeof(value_type));
+                _size--;
+                return ins;
+            }
+            move(ins + 1, end(), ins);
             // Destroy the moved-from duplicate at the old end
             _size--;
             destroy_at(end());
@@ -220,8 +225,13 @@ namespace toybox {
                 if (it->first == key) {
                     destroy_at(it);
                 } else {
-                    uninitialized_move(end() - 1, end(), end());
-                    move_backward(it, end() - 1, end());
+                    if constexpr (is_trivially_relocatable<value_type>::value) {
+                        memmove(static_cast<void*>(it + 1), static_cast<const void*>(it), (end() - it) * sizeof(value_type));
+                    } else {
+                        uninitialized_move(end() - 1, end(), end());
+                        move_backward(it, end() - 1, end());
+                        destroy_at(it);
+                    }
                     ++_size;
                 }
             } else {
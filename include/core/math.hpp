@@ -52,6 +52,26 @@ namespace toybox {
             return r;
         }
     }
+    template<>
+    __forceinline constexpr int64_t mul_fast(int32_t x, int32_t y) {
+        if consteval {
+            int64_t t = x;
+            return t * y;
+        } else {
+            // The 68000 has no 32 bit multiply, sum the 16 bit mulu partial products.
+            const bool negative = (x ^ y) < 0;
+            const uint32_t ux = x < 0 ? -static_cast<uint32_t>(x) : static_cast<uint32_t>(x);
+            const uint32_t uy = y < 0 ? -static_cast<uint32_t>(y) : static_cast<uint32_t>(y);
+            const uint16_t xl = static_cast<uint16_t>(ux), xh = static_cast<uint16_t>(ux >> 16);
+            const uint16_t yl = static_cast<uint16_t>(uy), yh = static_cast<uint16_t>(uy >> 16);
+            uint64_t r = mul_fast(xl, yl);
+            if (xh | yh) {
+                const uint64_t mid = static_cast<uint64_t>(mul_fast(xh, yl)) + mul_fast(xl, yh);
+                r += (mid << 16) + (static_cast<uint64_t>(mul_fast(xh, yh)) << 32);
+            }
+            return negative ? -static_cast<int64_t>(r) : static_cast<int64_t>(r);
+        }
+    }
 #endif
     
     template<integral Int>
@@ -84,6 +104,29 @@ namespace toybox {
             return r;
         }
     }
+    template<>
+    inline constexpr div_t<int32_t> div_fast(int64_t x, int32_t y) {
+        if consteval {
+            return div_t<int32_t>{ static_cast<int32_t>(x % y), static_cast<int32_t>(x / y) };
+        } else {
+            const uint32_t uy = y < 0 ? -static_cast<uint32_t>(y) : static_cast<uint32_t>(y);
+            if (uy > 0xffff) {
+                return div_t<int32_t>{ static_cast<int32_t>(x % y), static_cast<int32_t>(x / y) };
+            }
+            // Long division in 16 bit digits, the remainder is always less than
+            // the divisor so every step fits the quotient of a single divu.
+            const uint64_t ux = x < 0 ? -static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+            uint16_t r = 0;
+            uint32_t q = 0;
+            for (int shift = (ux >> 32) ? 48 : 16; shift >= 0; shift -= 16) {
+                const auto d = div_fast((static_cast<uint32_t>(r) << 16) | static_cast<uint16_t>(ux >> shift), static_cast<uint16_t>(uy));
+                q = (q << 16) | d.quot;
+                r = d.rem;
+            }
+            const int32_t quot = ((x < 0) != (y < 0)) ? -static_cast<int32_t>(q) : static_cast<int32_t>(q);
+            return div_t<int32_t>{ x < 0 ? -static_cast<int32_t>(r) : static_cast<int32_t>(r), quot };
+        }
+    }
 #endif
     
     template<integral Int, int Bits>
@@ -100,6 +143,14 @@ namespace toybox {
         template<integral OInt>
         constexpr base_fix_t(OInt v) : raw(static_cast<Int>(v) << Bits) {}
         constexpr base_fix_t(float v) : raw(static_cast<Int>(roundf(v * (static_cast<LargerInt>(1) << Bits)))) {}
+        template<integral OInt, int OBits>
+        constexpr explicit base_fix_t(base_fix_t<OInt, OBits> o) {
+            if constexpr (Bits >= OBits) {
+                raw = static_cast<Int>(static_cast<Int>(o.raw) << (Bits - OBits));
+            } else {
+                raw = static_cast<Int>(o.raw >> (OBits - Bits));
+            }
+        }
         
         constexpr explicit operator bool() const { return raw != 0; }
         template<integral OInt>
@@ -280,6 +331,12 @@ namespace toybox {
     };
 
     using fix16_t = base_fix_t<int16_t, 4>;
+    static_assert(sizeof(fix16_t) == 2);
+
+    /// 20:12 fixed point, for world coordinates beyond the ±2047 range of `fix16_t`.
+    /// Converts to and from `fix16_t` with a single shift.
+    using fix32_t = base_fix_t<int32_t, 12>;
+    static_assert(sizeof(fix32_t) == 4);
 
     namespace numbers {
         static inline constexpr fix16_t one = fix16_t(1);
@@ -291,7 +348,18 @@ namespace toybox {
     }
 
     fix16_t pow(fix16_t base, fix16_t exp); // Perf: integer exp; O(log n), good to horrible (1-many muls), otherwise O(1), horrible (~19 muls + 17 divs).
-    fix16_t sqrt(fix16_t x); // Perf: O(1), bad to horrible (up to 6 divs, typically 2-3)
+    /*
+     Table driven functions, using linear interpolation with no divs.
+     Results are within 1/16 (one fix16_t LSB) of the exact result rounded
+     to nearest. Results that overflow saturate to max, and undefined inputs
+     return max, or min for log2.
+     */
+    fix16_t sqrt(fix16_t x);  // Perf: O(1), good (1 mul)
+    fix16_t rsqrt(fix16_t x); // Perf: O(1), good (1 mul)
+    fix16_t reciprocal(fix16_t x); // Perf: O(1), good (1 mul)
+    fix16_t atan2(fix16_t y, fix16_t x); // Perf: O(1), good (3 muls)
+    fix16_t exp2(fix16_t x);  // Perf: O(1), good (no mul)
+    fix16_t log2(fix16_t x);  // Perf: O(1), good (1 mul)
 
     fix16_t sin(fix16_t x);  // Perf: O(1), good (1 div)
     fix16_t cos(fix16_t x);  // Perf: O(1), good (1 div via sin)
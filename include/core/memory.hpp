@@ -74,6 +74,8 @@ namespace toybox {
         }
     };
     static_assert(sizeof(unique_ptr_c<void*>) == sizeof(void*), "unique_ptr_c size mismatch.");
+    template<typename T>
+    struct is_trivially_relocatable<unique_ptr_c<T>> : public true_type {};
 
     namespace detail {
         struct shared_count_t {
@@ -149,6 +151,8 @@ namespace toybox {
         }
     };
     static_assert(sizeof(shared_ptr_c<void*>) == sizeof(void*) * 2, "shared_ptr_c size mismatch.");
+    template<typename T>
+    struct is_trivially_relocatable<shared_ptr_c<T>> : public true_type {};
 
     template<typename U, typename T>
     requires has_virtual_destructor<T>::value
@@ -0,0 +1,74 @@
+//
+//  memory_telemetry.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/cincludes.hpp"
+
+namespace toybox {
+
+/**
+ A `memory_telemetry_c` tracks allocations from the global `operator new`
+ and all `pool_allocator_c` instances.
+ Tracks live and peak bytes, allocations per frame, a histogram of sizes,
+ and live bytes per label. Allocations are labeled by the innermost
+ `with_label()` when made.
+ Only available when `TOYBOX_MEMORY_TELEMETRY` is set, default for host
+ builds, otherwise `with_label()` only executes the commands.
+ */
+class memory_telemetry_c {
+public:
+    template<class Commands>
+    static void with_label(const char* label, Commands commands) {
+#if TOYBOX_MEMORY_TELEMETRY
+        push_label(label);
+        commands();
+        pop_label();
+#else
+        commands();
+#endif
+    }
+    
+#if TOYBOX_MEMORY_TELEMETRY
+    static constexpr int histogram_count = 12;
+    static constexpr int max_label_count = 32;
+    
+    struct stats_s {
+        size_t live_bytes;
+        size_t peak_bytes;
+        size_t live_count;
+        size_t total_count;
+        size_t frame_count;         // Allocations since begin_frame()
+        size_t peak_frame_count;    // Max allocations in any frame
+    };
+    struct label_stats_s {
+        const char* label;
+        size_t live_bytes;
+        size_t peak_bytes;
+    };
+    
+    static void did_allocate(const void* ptr, size_t size);
+    static void did_deallocate(const void* ptr);
+    static void begin_frame();
+
+    static stats_s stats();
+    /// Upper size limit of histogram bucket, last bucket is unbounded.
+    static size_t histogram_limit(int bucket);
+    static size_t histogram(int bucket);
+    static int label_count();
+    static label_stats_s label_stats(int index);
+    static const char* label();
+
+    static void print_report(const char* title);
+    
+private:
+    static void push_label(const char* label);
+    static void pop_label();
+#endif
+};
+
+}
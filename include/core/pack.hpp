@@ -0,0 +1,73 @@
+//
+//  pack.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/stream.hpp"
+#include "core/vector.hpp"
+
+namespace toybox {
+
+    /**
+     `pack_c` is a read only archive of files in a single file, opened once
+     so that each file is read with a seek and a read instead of a GEMDOS
+     open and close. Files are 16 byte aligned, and found by a binary search
+     of a table of contents sorted by name.
+     Names compare ignoring case and with `\` and `/` as equal, so host and
+     target paths find the same file.
+     While mounted, `memstream_c` and `iffstream_c` opened by path read
+     files from the pack before trying the file system.
+     */
+    class pack_c : public nocopy_c {
+    public:
+        static constexpr size_t alignment = 16;
+        struct entry_s {
+            uint32_t offset;
+            uint32_t size;
+            char name[24];      // Lower case and `/` separated, null terminated
+        };
+        static constexpr size_t max_name_length = sizeof(entry_s::name) - 1;
+
+        pack_c(const char* path);
+        ~pack_c();
+
+        __forceinline bool good() const __pure { return _stream.get() != nullptr; }
+        __forceinline const char* path() const __pure { return _path; }
+        __forceinline int size() const __pure { return _entries.size(); }
+        __forceinline const entry_s* begin() const __pure { return _entries.begin(); }
+        __forceinline const entry_s* end() const __pure { return _entries.end(); }
+
+        /// Returns the entry for name, or nullptr if not in the pack.
+        const entry_s* find(const char* name) const;
+        /**
+         Returns a `substream_c` positioned at the start of the named file, or
+         nullptr if not in the pack. All files share the one open pack file,
+         so seek before reading if another file may have been read since.
+         */
+        shared_ptr_c<stream_c> open(const char* name) const;
+
+        /// Sets the pack searched by streams opened by path, or nullptr for none.
+        static void mount(const pack_c* pack);
+        static const pack_c* mounted();
+
+#ifndef __M68000__
+        /**
+         Writes a pack of count files to path, named by their paths as given.
+         If compress, files that get smaller are stored packed with
+         `lz_compress()`, and are unpacked when loaded by `memstream_c`.
+         Host only, used by tools.
+         */
+        static bool create(const char* path, const char* const* files, int count, bool compress = false);
+#endif
+
+    private:
+        char* _path;
+        shared_ptr_c<stream_c> _stream;
+        vector_c<entry_s, 0> _entries;
+    };
+
+}
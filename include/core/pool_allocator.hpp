@@ -8,9 +8,20 @@
 #pragma once
 
 #include "core/algorithm.hpp"
+#include "core/memory_telemetry.hpp"
 
 namespace toybox {
 
+/**
+ Allocation statistics for a `pool_allocator_c`.
+ */
+struct pool_allocator_stats_s {
+    size_t current_count;   // Blocks currently allocated
+    size_t peak_count;      // Max blocks allocated at any one time
+    int chunk_count;        // Chunks reserved, always 1 for fixed-size pools
+    size_t reserved_bytes;  // Bytes reserved for chunks
+};
+
 /**
  A `pool_allocator_c` is a fixed-size memory pool allocator.
  Pre-allocates a pool of fixed-size blocks and manages them via a free list.
@@ -25,34 +36,37 @@ public:
     using type = block_t*;
     static void* allocate() {
         assert(first_block && "Allocator pool exhausted");
-#ifndef __M68000__
         _alloc_count++;
         _peak_alloc_count = MAX(_peak_alloc_count, _alloc_count);
-#endif
         auto ptr = reinterpret_cast<T*>(&first_block->data[0]);
         first_block = first_block->next;
+#if TOYBOX_MEMORY_TELEMETRY
+        memory_telemetry_c::did_allocate(ptr, alloc_size);
+#endif
         return ptr;
     };
     static void deallocate(void* ptr) {
-#ifndef __M68000__
-        _alloc_count--;
+#if TOYBOX_MEMORY_TELEMETRY
+        memory_telemetry_c::did_deallocate(ptr);
 #endif
+        _alloc_count--;
         block_t* block = reinterpret_cast<block_t*>(static_cast<void**>(ptr) - 1);
         block->next = first_block;
         first_block = block;
     }
-#ifndef __M68000__
-    static int peak_alloc_count() { return _peak_alloc_count; }
-#endif
+    static int peak_alloc_count() { return (int)_peak_alloc_count; }
+    /// Fixed-size pools are statically allocated, and can not be trimmed.
+    static void trim() {}
+    static pool_allocator_stats_s stats() {
+        return { _alloc_count, _peak_alloc_count, 1, sizeof(block_t) * Count };
+    }
 private:
     struct block_t {
         block_t* next;
         uint8_t data[alloc_size];
     };
-#ifndef __M68000__
-    static inline int _alloc_count = 0;
-    static inline int _peak_alloc_count = 0;
-#endif
+    static inline size_t _alloc_count = 0;
+    static inline size_t _peak_alloc_count = 0;
     static inline block_t* first_block = [] {
         static block_t s_blocks[Count];
         for (int i = 0; i < Count - 1; i++) {
@@ -67,42 +81,113 @@ private:
  Dynamic specialization of `pool_allocator_c` for Count == 0.
  Grows the pool automatically by allocating chunks as needed.
  Chunk sizes start at 8 and double each time (capped at 256).
+ Each chunk has its own free list and occupancy count, an allocated block
+ refers back to its chunk, so fully free chunks can be released by `trim()`.
  */
 template <class T>
 class pool_allocator_c<T, 0> {
     struct block_t;
+    struct chunk_t;
 public:
     static constexpr size_t alloc_size = sizeof(T);
     using type = block_t*;
     static void* allocate() {
-        if (!first_block) _grow_pool();
-        auto ptr = reinterpret_cast<T*>(&first_block->data[0]);
-        first_block = first_block->next;
-        return ptr;
+        chunk_t* chunk = _current_chunk;
+        if (!chunk || !chunk->first_block) {
+            chunk = _find_free_chunk();
+        }
+        block_t* block = chunk->first_block;
+        chunk->first_block = block->next;
+        chunk->alloc_count++;
+        block->chunk = chunk;
+        _current_chunk = chunk;
+        _alloc_count++;
+        _peak_alloc_count = MAX(_peak_alloc_count, _alloc_count);
+#if TOYBOX_MEMORY_TELEMETRY
+        memory_telemetry_c::did_allocate(&block->data[0], alloc_size);
+#endif
+        return reinterpret_cast<T*>(&block->data[0]);
     }
     static void deallocate(void* ptr) {
+#if TOYBOX_MEMORY_TELEMETRY
+        memory_telemetry_c::did_deallocate(ptr);
+#endif
         block_t* block = reinterpret_cast<block_t*>(static_cast<void**>(ptr) - 1);
-        block->next = first_block;
-        first_block = block;
+        chunk_t* chunk = block->chunk;
+        block->next = chunk->first_block;
+        chunk->first_block = block;
+        chunk->alloc_count--;
+        _current_chunk = chunk;
+        _alloc_count--;
+    }
+    static int peak_alloc_count() { return (int)_peak_alloc_count; }
+    /// Release all chunks with no allocated blocks back to the heap.
+    static void trim() {
+        chunk_t** link = &_first_chunk;
+        while (*link) {
+            chunk_t* chunk = *link;
+            if (chunk->alloc_count == 0) {
+                *link = chunk->next;
+                _free(chunk);
+            } else {
+                link = &chunk->next;
+            }
+        }
+        _current_chunk = _first_chunk;
+    }
+    static pool_allocator_stats_s stats() {
+        pool_allocator_stats_s stats = { _alloc_count, _peak_alloc_count, 0, 0 };
+        for (chunk_t* chunk = _first_chunk; chunk; chunk = chunk->next) {
+            stats.chunk_count++;
+            stats.reserved_bytes += sizeof(chunk_t) + sizeof(block_t) * chunk->block_count;
+        }
+        return stats;
     }
 private:
     struct block_t {
-        block_t* next;
+        union {
+            block_t* next;      // When free
+            chunk_t* chunk;     // When allocated
+        };
         uint8_t data[alloc_size];
     };
-    static void _grow_pool() {
-        const size_t chunk_size = MIN(s_next_chunk_size, size_t(256));
-        block_t* chunk = new block_t[chunk_size];
-        for (size_t i = 0; i < chunk_size - 1; ++i) {
-            chunk[i].next = &chunk[i + 1];
+    struct chunk_t {
+        chunk_t* next;
+        block_t* first_block;
+        uint16_t block_count;
+        uint16_t alloc_count;
+        block_t blocks[];
+    };
+    static chunk_t* _find_free_chunk() {
+        for (chunk_t* chunk = _first_chunk; chunk; chunk = chunk->next) {
+            if (chunk->first_block) {
+                return chunk;
+            }
+        }
+        return _grow_pool();
+    }
+    static chunk_t* _grow_pool() {
+        const size_t block_count = MIN(s_next_chunk_size, size_t(256));
+        chunk_t* chunk = static_cast<chunk_t*>(_malloc(sizeof(chunk_t) + sizeof(block_t) * block_count));
+        hard_assert(chunk && "Allocator pool out of memory");
+        for (size_t i = 0; i < block_count - 1; ++i) {
+            chunk->blocks[i].next = &chunk->blocks[i + 1];
         }
-        chunk[chunk_size - 1].next = first_block;
-        first_block = chunk;
+        chunk->blocks[block_count - 1].next = nullptr;
+        chunk->first_block = &chunk->blocks[0];
+        chunk->block_count = block_count;
+        chunk->alloc_count = 0;
+        chunk->next = _first_chunk;
+        _first_chunk = chunk;
         if (s_next_chunk_size < 256) {
             s_next_chunk_size *= 2;
         }
+        return chunk;
     }
-    static inline block_t* first_block = nullptr;
+    static inline chunk_t* _first_chunk = nullptr;
+    static inline chunk_t* _current_chunk = nullptr;
+    static inline size_t _alloc_count = 0;
+    static inline size_t _peak_alloc_count = 0;
     static inline size_t s_next_chunk_size = 8;
 };
 
@@ -0,0 +1,119 @@
+//
+//  ring_buffer.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/utility.hpp"
+
+namespace toybox {
+
+    /**
+     `ring_buffer_c` is a bounded, allocation free, single-producer and
+     single-consumer queue with a power of two capacity.
+     Lock free, and safe to use between an interrupt handler and the main loop
+     on target, or between two threads on host.
+     Only the producer may call `push()` and `emplace()`, and only the consumer
+     may call `front()`, `pop()` and `clear()`.
+     Indexes run freely and are masked on access, so all Count slots are usable.
+     */
+    template<class Type, int Count>
+    class ring_buffer_c : public nocopy_c {
+        static_assert(Count > 0 && (Count & (Count - 1)) == 0, "Count must be a power of two");
+        static_assert(Count <= 0x4000, "Count must fit a 16 bit index");
+    public:
+        using value_type = Type;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+
+        ring_buffer_c() : _head(0), _tail(0) {}
+        ~ring_buffer_c() { clear(); }
+
+        __forceinline constexpr int capacity() const __pure { return Count; }
+        __forceinline int size() const {
+            return static_cast<uint16_t>(load_acquire(_head) - load_acquire(_tail));
+        }
+        __forceinline bool empty() const { return load_acquire(_head) == load_acquire(_tail); }
+        __forceinline bool full() const { return size() == Count; }
+
+        /// Pushes a copy of value, returns false if full.
+        __forceinline bool push(const_reference value) {
+            return emplace(value);
+        }
+        /// Constructs a value in place, returns false if full.
+        template<class... Args>
+        bool emplace(Args&&... args) {
+            const uint16_t head = _head;
+            if (static_cast<uint16_t>(head - load_acquire(_tail)) == Count) {
+                return false;
+            }
+            construct_at(slot(head), forward<Args>(args)...);
+            store_release(_head, head + 1);
+            return true;
+        }
+
+        /// Returns the oldest value, or nullptr if empty.
+        Type* front() {
+            const uint16_t tail = _tail;
+            return tail == load_acquire(_head) ? nullptr : slot(tail);
+        }
+        /// Moves the oldest value into value, returns false if empty.
+        bool pop(reference value) {
+            Type* ptr = front();
+            if (ptr == nullptr) {
+                return false;
+            }
+            value = move(*ptr);
+            discard(ptr);
+            return true;
+        }
+        /// Destroys the oldest value, returns false if empty.
+        bool pop() {
+            Type* ptr = front();
+            if (ptr == nullptr) {
+                return false;
+            }
+            discard(ptr);
+            return true;
+        }
+        void clear() {
+            while (pop()) {}
+        }
+
+    private:
+        static constexpr uint16_t mask = Count - 1;
+        __forceinline Type* slot(uint16_t index) { return _buffer[index & mask].template ptr<0>(); }
+        __forceinline void discard(Type* ptr) {
+            destroy_at(ptr);
+            store_release(_tail, _tail + 1);
+        }
+
+        // A 16 bit move is atomic on 68000, and interrupts run on the same
+        // CPU, so a compiler barrier is all the ordering needed on target.
+        static __forceinline uint16_t load_acquire(const uint16_t& index) {
+#ifdef __M68000__
+            const uint16_t value = *static_cast<const volatile uint16_t*>(&index);
+            __asm__ volatile ("" : : : "memory");
+            return value;
+#else
+            return __atomic_load_n(&index, __ATOMIC_ACQUIRE);
+#endif
+        }
+        static __forceinline void store_release(uint16_t& index, uint16_t value) {
+#ifdef __M68000__
+            __asm__ volatile ("" : : : "memory");
+            *static_cast<volatile uint16_t*>(&index) = value;
+#else
+            __atomic_store_n(&index, value, __ATOMIC_RELEASE);
+#endif
+        }
+
+        uint16_t _head;
+        uint16_t _tail;
+        aligned_membuf_s<Type> _buffer[Count];
+    };
+
+}
@@ -0,0 +1,59 @@
+//
+//  slab_allocator.hpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#pragma once
+
+#include "core/cincludes.hpp"
+
+namespace toybox {
+
+/**
+ A `slab_allocator_c` serves small allocations from per size-class free lists.
+ It backs the global `operator new` for sizes up to `max_alloc_size`, larger
+ sizes pass through to `_malloc`.
+ Each size class grows by fixed size chunks, so the owning chunk, and thereby
+ size class, of a pointer is found by a binary search without any per
+ allocation header. Pointers not owned by a chunk are passed on to `_free`,
+ this keeps `delete` of memory from `_malloc` working as before.
+ */
+class slab_allocator_c {
+public:
+    static constexpr int size_class_count = 6;
+    static constexpr size_t size_classes[size_class_count] = { 8, 16, 24, 32, 64, 128 };
+    static constexpr size_t max_alloc_size = size_classes[size_class_count - 1];
+    static constexpr size_t chunk_size = TOYBOX_SLAB_CHUNK_SIZE;
+    static constexpr int max_chunk_count = TOYBOX_SLAB_MAX_CHUNKS;
+
+    /// Size class index for size, or -1 if size is larger than `max_alloc_size`.
+    static constexpr int size_class(size_t size) {
+        constexpr int8_t s_classes[] = { 0, 0, 1, 2, 3, 4, 4, 4, 4, 5, 5, 5, 5, 5, 5, 5, 5 };
+        return size <= max_alloc_size ? s_classes[(size + 7) >> 3] : -1;
+    }
+
+    static void* allocate(size_t size);
+    static void deallocate(void* ptr);
+    static bool owns(const void* ptr);
+
+private:
+    struct block_t {
+        block_t* next;
+    };
+    struct chunk_t {
+        union {
+            uint8_t size_class;
+            max_align_t _align;
+        };
+        uint8_t data[];
+    };
+    static_assert(size_classes[0] >= sizeof(block_t));
+    static_assert(chunk_size >= sizeof(chunk_t) + max_alloc_size * 8);
+
+    static bool _grow(int size_class);
+    static chunk_t* _find_chunk(const void* ptr);
+};
+
+}
@@ -7,7 +7,7 @@
 
 #pragma once
 
-#include "core/cincludes.hpp"
+#include "core/geometry.hpp"
 
 namespace toybox {
     
@@ -61,12 +61,99 @@ namespace toybox {
         }
         const_reference back() const {
             assert(_size > 0 && "Span is empty");
-            return _begin + _size;
+            return _begin[_size - 1];
         }
 
     private:
         iterator _begin;
         int _size;
     };
-    
+
+    /**
+     A non-owning view of a 2D grid of elements, a pointer to the first
+     element, a size, and a stride in elements between rows.
+     Indexing a row returns a `span_c`, so inner loops can walk a row with a
+     pointer increment per element, instead of `x + y * width` per element.
+     Bounds are only checked in debug builds.
+     */
+    template<class Type>
+    class span2d_c {
+    public:
+        using value_type = Type;
+        using pointer = value_type*;
+        using const_pointer = const value_type*;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using row_type = span_c<Type>;
+        using const_row_type = span_c<const Type>;
+
+        template<class TypeI>
+        struct row_iterator_s {
+            __forceinline span_c<TypeI> operator*() const { return span_c<TypeI>(_row, _width); }
+            __forceinline row_iterator_s& operator++() { _row += _stride; return *this; }
+            __forceinline row_iterator_s operator++(int) { auto tmp = *this; _row += _stride; return tmp; }
+            __forceinline bool operator==(const row_iterator_s& o) const { return _row == o._row; }
+            TypeI* _row;
+            int _width;
+            int _stride;
+        };
+        using iterator = row_iterator_s<Type>;
+        using const_iterator = row_iterator_s<const Type>;
+
+        span2d_c() : _data(nullptr), _width(0), _height(0), _stride(0) {}
+        span2d_c(pointer data, int width, int height, int stride) :
+            _data(data), _width(width), _height(height), _stride(stride)
+        {
+            assert(width >= 0 && height >= 0 && stride >= width && "Invalid span dimensions");
+        }
+        span2d_c(pointer data, size_s size) : span2d_c(data, size.width, size.height, size.width) {}
+        span2d_c(const span2d_c& o) = default;
+        span2d_c& operator=(const span2d_c& o) = default;
+
+        __forceinline pointer data() { return _data; }
+        __forceinline const_pointer data() const { return _data; }
+        __forceinline int width() const __pure { return _width; }
+        __forceinline int height() const __pure { return _height; }
+        __forceinline int stride() const __pure { return _stride; }
+        __forceinline size_s size() const __pure { return size_s(_width, _height); }
+
+        __forceinline iterator begin() { return iterator{ _data, _width, _stride }; }
+        __forceinline const_iterator begin() const { return const_iterator{ _data, _width, _stride }; }
+        __forceinline iterator end() { return iterator{ _data + _height * _stride, _width, _stride }; }
+        __forceinline const_iterator end() const { return const_iterator{ _data + _height * _stride, _width, _stride }; }
+
+        __forceinline row_type operator[](int y) {
+            return row_type(row_data(y), _width);
+        }
+        __forceinline const_row_type operator[](int y) const {
+            return const_row_type(row_data(y), _width);
+        }
+        __forceinline reference operator[](int x, int y) {
+            assert(x >= 0 && x < _width && "Column out of bounds");
+            return row_data(y)[x];
+        }
+        __forceinline const_reference operator[](int x, int y) const {
+            assert(x >= 0 && x < _width && "Column out of bounds");
+            return row_data(y)[x];
+        }
+        __forceinline reference operator[](point_s at) { return (*this)[at.x, at.y]; }
+        __forceinline const_reference operator[](point_s at) const { return (*this)[at.x, at.y]; }
+
+        /// Returns a view of the rect within this view, sharing the stride.
+        span2d_c subspan(const rect_s& rect) const {
+            assert(rect.contained_by(rect_s(size())) && "Rect out of bounds");
+            return span2d_c(_data + rect.origin.y * _stride + rect.origin.x, rect.size.width, rect.size.height, _stride);
+        }
+
+    private:
+        __forceinline pointer row_data(int y) const {
+            assert(y >= 0 && y < _height && "Row out of bounds");
+            return _data + y * _stride;
+        }
+        pointer _data;
+        int _width;
+        int _height;
+        int _stride;
+    };
+
 }
@@ -37,6 +37,14 @@ namespace toybox {
         virtual size_t read(uint8_t* buf, size_t count = 1) = 0;
         virtual size_t write(const uint8_t* buf, size_t count = 1) = 0;
 
+        /**
+         Returns a pointer to the next count bytes and advances past them, or
+         nullptr if the stream can not provide them without copying.
+         The pointer is valid until the next operation on the stream.
+         Data is not byte swapped, callers must `hton()` as needed.
+         */
+        virtual const uint8_t* view(size_t count);
+
         template<typename T> requires (!same_as<T, uint8_t>)
         __forceinline size_t read(T* buf, size_t count = 1) { return read(reinterpret_cast<uint8_t*>(buf), count * sizeof(T)); }
         template<typename T> requires (!same_as<T, uint8_t>)
@@ -141,5 +149,65 @@ namespace toybox {
         size_t _pos;
         size_t _max;
     };
+
+
+    /**
+     `memstream_c` is a read only stream over a contiguous buffer in memory.
+     The buffer is either borrowed, or owned and loaded with a single read of
+     a whole file or stream, removing all seek and small read overhead.
+     Files in the mounted `pack_c` are read with one seek and read, other
+     files are memory mapped on host, and read with one `Fread` on target.
+     `view()` never copies, so parsers can decode straight out of the buffer.
+     Files and streams packed with `lz_compress()` are unpacked when loaded,
+     so any parser reads packed assets unchanged.
+     */
+    class memstream_c final : public stream_c {
+    public:
+        memstream_c(const uint8_t* buf, size_t len);
+        memstream_c(const char* path);
+        memstream_c(stream_c& stream);
+        virtual ~memstream_c();
+
+        __forceinline const uint8_t* data() const __pure { return _buf; }
+        __forceinline size_t size() const __pure { return _len; }
+        /**
+         Hands over the buffer, as `_malloc` allocated memory of `size()`
+         bytes owned by the caller, leaving the stream empty. Owned buffers
+         are handed over without copying. Returns nullptr if not good.
+         */
+        uint8_t* release();
+
+        virtual bool good() const override __pure;
+        virtual ptrdiff_t tell() const override __pure;
+        virtual ptrdiff_t seek(ptrdiff_t pos, seekdir_e way) override;
+
+        using stream_c::read;
+        virtual size_t read(uint8_t* buf, size_t count = 1) override;
+        using stream_c::write;
+        virtual size_t write(const uint8_t* buf, size_t count = 1) override;
+        virtual const uint8_t* view(size_t count) override;
+
+        /**
+         Hands over a `_malloc` allocated buffer holding the whole contents of
+         path, the next `memstream_c` opened for path takes ownership instead
+         of reading the file. Used to load files ahead of parsing them.
+         Single slot, calling again frees any unclaimed buffer.
+         */
+        static void prefetch(const char* path, uint8_t* buf, size_t len);
+
+    private:
+        enum class storage_e : uint8_t {
+            borrowed, allocated, mapped
+        };
+        static void free_buffer(const uint8_t* buf, size_t len, storage_e storage);
+        bool load(stream_c& stream);
+        bool load_packed(stream_c& stream);
+        bool unpack();
+
+        const uint8_t* _buf;
+        size_t _len;
+        size_t _pos;
+        storage_e _storage;
+    };
     
 }
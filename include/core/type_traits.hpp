@@ -133,6 +133,14 @@ namespace toybox {
 #endif
     
     template<typename T> struct is_trivially_copyable : public bool_constant<__is_trivially_copyable(T)> {};
+
+    /**
+     A type is trivially relocatable if moving it to a new address, and ending
+     the lifetime of the source, is equivalent to copying its bytes.
+     Containers relocate such types with `memmove`. Specialize to opt in types
+     with user defined copy, move or destructor that do not point into themselves.
+     */
+    template<typename T> struct is_trivially_relocatable : public bool_constant<is_trivially_copyable<T>::value> {};
   
     template<typename T> struct is_trivial : public bool_constant<__is_trivial(T)> {};
 
@@ -21,11 +21,52 @@ namespace toybox {
 
         virtual size_t read(uint8_t* buf, size_t count = 1) override;
         virtual size_t write(const uint8_t* buf, size_t count = 1) override;
+        virtual const uint8_t* view(size_t count) override;
 
     private:
         shared_ptr_c<stream_c> _stream;
         ptrdiff_t _origin;
         ptrdiff_t _length;
     };
+
+    /**
+     `bufstream_c` wraps a stream with a read-ahead and write-behind buffer.
+     Small reads and writes are served from the buffer, so a run of tiny
+     reads costs a single read of the wrapped stream. Reads and writes of at
+     least the buffer size bypass the buffer. Seeks within the buffered range
+     only move the position, and never seek the wrapped stream.
+     Writes are flushed on `flush()`, seeking, reading and destruction.
+     `view()` succeeds for reads already in the buffer.
+     */
+    class bufstream_c final : public stream_c {
+    public:
+        static constexpr size_t default_size = 512;
+
+        bufstream_c(shared_ptr_c<stream_c> stream, size_t size = default_size);
+        virtual ~bufstream_c();
+
+        virtual bool good() const override __pure;
+        virtual ptrdiff_t tell() const override __pure;
+        virtual ptrdiff_t seek(ptrdiff_t pos, seekdir_e way) override;
+        virtual bool flush() override;
+
+        using stream_c::read;
+        virtual size_t read(uint8_t* buf, size_t count = 1) override;
+        using stream_c::write;
+        virtual size_t write(const uint8_t* buf, size_t count = 1) override;
+        virtual const uint8_t* view(size_t count) override;
+
+    private:
+        bool flush_buffer();
+        void drop_read_buffer();
+
+        shared_ptr_c<stream_c> _stream;
+        unique_ptr_c<uint8_t> _buf;
+        const size_t _size;
+        ptrdiff_t _base;  // Position of _buf[0] in the wrapped stream
+        size_t _pos;      // Position in buffer
+        size_t _len;      // Valid bytes in buffer
+        bool _dirty;      // Buffer holds unwritten bytes
+    };
     
 }
@@ -32,14 +32,98 @@ namespace toybox {
     requires (sizeof(Type) == 4)
     __forceinline void hton(Type& value) { value = htonl(value); }
 
-    void hton_struct(void* ptr, const char* layout);
+    namespace detail {
+        struct layout_field_s {
+            uint16_t offset;
+            uint8_t size;
+        };
+
+        /// Calls `func(offset, size)` for every word and long in layout, returns the total size.
+        template<class F>
+        consteval size_t parse_struct_layout(const char* layout, F&& func) {
+            size_t offset = 0;
+            while (*layout) {
+                size_t cnt = 0;
+                bool has_cnt = false;
+                while (*layout >= '0' && *layout <= '9') {
+                    cnt = cnt * 10 + (*layout++ - '0');
+                    has_cnt = true;
+                }
+                if (!has_cnt) cnt = 1;
+                size_t size = 0;
+                switch (*layout++) {
+                    case 'b': size = 1; break;
+                    case 'w': size = 2; break;
+                    case 'l': size = 4; break;
+                    default:
+                        hard_assert(0 && "Unsupported struct layout specifier");
+                        break;
+                }
+                while (cnt--) {
+                    if (size > 1) func(offset, size);
+                    offset += size;
+                }
+            }
+            return offset;
+        }
+
+        /**
+         The byte swap routine for a `struct_layout`, generated and fully
+         unrolled at compile time. Fields are accessed with `memcpy` as
+         layouts such as AIFF COMM have longs on unaligned offsets.
+         */
+        template<class T>
+        struct struct_swap_s {
+            static constexpr const char* layout = struct_layout<T>::value;
+            static constexpr size_t count = []() consteval {
+                size_t count = 0;
+                parse_struct_layout(layout, [&](size_t, size_t) { count++; });
+                return count;
+            }();
+            static constexpr size_t size = parse_struct_layout(layout, [](size_t, size_t) {});
+            static_assert(size <= sizeof(T), "struct_layout is larger than the struct");
+            struct fields_s { layout_field_s field[count > 0 ? count : 1]; };
+            static constexpr fields_s fields = []() consteval {
+                fields_s fields{};
+                size_t i = 0;
+                parse_struct_layout(layout, [&](size_t offset, size_t size) {
+                    fields.field[i++] = { static_cast<uint16_t>(offset), static_cast<uint8_t>(size) };
+                });
+                return fields;
+            }();
+
+            template<size_t I = 0>
+            static __forceinline void swap(uint8_t* ptr) {
+                if constexpr (I < count) {
+                    constexpr layout_field_s field = fields.field[I];
+                    if constexpr (field.size == 2) {
+                        uint16_t v;
+                        memcpy(&v, ptr + field.offset, 2);
+                        v = htons(v);
+                        memcpy(ptr + field.offset, &v, 2);
+                    } else {
+                        uint32_t v;
+                        memcpy(&v, ptr + field.offset, 4);
+                        v = htonl(v);
+                        memcpy(ptr + field.offset, &v, 4);
+                    }
+                    swap<I + 1>(ptr);
+                }
+            }
+        };
+    }
+
     template<class_type T>
     __forceinline void hton(T& value) {
-        hton_struct(&value, struct_layout<T>::value);
+        detail::struct_swap_s<T>::swap(reinterpret_cast<uint8_t*>(&value));
     }
 
     template<class Type>
     void hton(Type* buf, size_t count) {
+        if constexpr (class_type<Type>) {
+            // Layouts with no words or longs need no swapping at all.
+            if constexpr (detail::struct_swap_s<Type>::count == 0) return;
+        }
         while (count--) {
             hton(*buf);
             buf++;
@@ -378,6 +462,8 @@ namespace toybox {
         T1 first;
         T2 second;
     };
+    template<class T1, class T2>
+    struct is_trivially_relocatable<pair_c<T1, T2>> : public bool_constant<is_trivially_relocatable<T1>::value && is_trivially_relocatable<T2>::value> {};
 
     template< class T1, class T2 >
     __forceinline pair_c<T1, T1> make_pair( T1&& f, T2&& s) { return pair_c<T1, T2>(forward<T1>(f), forward<T2>(s)); }
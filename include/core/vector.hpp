@@ -16,12 +16,13 @@ namespace toybox {
      `vector_c` is a minimal implementation of `std::vector`.
      When Count > 0: Uses statically allocated backing store for performance.
      When Count == 0: Uses dynamically allocated backing store with automatic growth.
+     Storage can be overridden, see `small_vector_c`.
      */
-    template<class Type, int Count>
-    class vector_c : public nocopy_c,
-                     private conditional<Count == 0,
-                                        detail::base_buffer_dynamic_c<Type>,
-                                        detail::base_buffer_static_c<Type, Count>>::type
+    template<class Type, int Count,
+             class Storage = typename conditional<Count == 0,
+                                                  detail::base_buffer_dynamic_c<Type>,
+                                                  detail::base_buffer_static_c<Type, Count>>::type>
+    class vector_c : public nocopy_c, private Storage
     {
     public:
         using value_type = Type;
@@ -38,13 +39,13 @@ namespace toybox {
             copy(init.begin(), init.end(), begin());
             _size = (int)init.size();
         }
-        constexpr vector_c(const vector_c& o) requires (Count == 0) : _size(0) {
+        constexpr vector_c(const vector_c& o) requires (Storage::__is_growable) : _size(0) {
             this->__ensure_capacity(o._size, _size);
             uninitialized_copy(o.begin(), o.end(), begin());
             _size = o._size;
         }
-        constexpr vector_c(vector_c&& o) requires (Count == 0) : _size(o._size) {
-            this->__take_ownership(o);
+        constexpr vector_c(vector_c&& o) requires (Storage::__is_growable) : _size(o._size) {
+            this->__take_ownership(o, o._size);
             o._size = 0;
         }
                                             
@@ -52,7 +53,7 @@ namespace toybox {
             clear();
         }
             
-        vector_c& operator=(const vector_c& o) requires (Count == 0) {
+        vector_c& operator=(const vector_c& o) requires (Storage::__is_growable) {
             if (this == &o) return *this;
             clear();
             this->__ensure_capacity(o._size, _size);
@@ -61,11 +62,11 @@ namespace toybox {
             return *this;
         }
         
-        vector_c& operator=(vector_c&& o) requires (Count == 0) {
+        vector_c& operator=(vector_c&& o) requires (Storage::__is_growable) {
             if (this == &o) return *this;
             clear();
             this->__release_ownership();
-            this->__take_ownership(o);
+            this->__take_ownership(o, o._size);
             _size = o._size;
             o._size = 0;
             return *this;
@@ -146,9 +147,20 @@ namespace toybox {
         }
 
         iterator insert(const_iterator pos, const_reference value) {
-            this->__ensure_capacity(_size + 1, _size);
             assert(pos >= begin() && pos <= end() && "Invalid insert position");
-            iterator ins = (iterator)pos;
+            // Growing may reallocate, so pos is only valid as an index
+            const int at = (int)(pos - begin());
+            this->__ensure_capacity(_size + 1, _size);
+            iterator ins = begin() + at;
+            if constexpr (is_trivially_relocatable<Type>::value) {
+                // Value may be an element that is shifted up
+                const Type* src = &value;
+                if (src >= ins && src < end()) src++;
+                relocate_up(ins);
+                construct_at(ins, *src);
+                _size++;
+                return ins;
+            }
             // Construct new element at end first (into uninitialized memory)
             construct_at(end(), value);
             _size++;
@@ -161,13 +173,21 @@ namespace toybox {
             return ins;
         }
         __forceinline iterator insert(int at, const_reference value) {
-            return insert(begin() + at, forward<value_type>(value));
+            return insert(begin() + at, value);
         }
         template<class... Args>
         iterator emplace(Type* pos, Args&&... args) {
-            this->__ensure_capacity(_size + 1, _size);
             assert(pos >= begin() && pos <= end() && "Invalid insert position");
-            iterator ins = (iterator)pos;
+            // Growing may reallocate, so pos is only valid as an index
+            const int at = (int)(pos - begin());
+            this->__ensure_capacity(_size + 1, _size);
+            iterator ins = begin() + at;
+            if constexpr (is_trivially_relocatable<Type>::value) {
+                relocate_up(ins);
+                construct_at(ins, forward<Args>(args)...);
+                _size++;
+                return ins;
+            }
             // Construct new element at end first (into uninitialized memory)
             construct_at(end(), forward<Args>(args)...);
             _size++;
@@ -187,9 +207,14 @@ namespace toybox {
         iterator erase(const_iterator pos) {
             assert(_size > 0 && "Vector is empty");
             assert(pos >= begin() && pos < end() && "Invalid erase position");
-            destroy_at(pos);
             iterator ins = (iterator)pos;
-            move((iterator)pos + 1, end(), ins);
+            if constexpr (is_trivially_relocatable<Type>::value) {
+                destroy_at(ins);
+                memmove(static_cast<void*>(ins), static_cast<const void*>(ins + 1), (end() - ins - 1) * sizeof(Type));
+                _size--;
+                return ins;
+            }
+            move(ins + 1, end(), ins);
             // Destroy the moved-from duplicate at the old end
             _size--;
             destroy_at(end());
@@ -216,12 +241,25 @@ namespace toybox {
             return this->__capacity();
         }
 
-        void reserve(int new_cap) requires (Count == 0) {
+        void reserve(int new_cap) requires (Storage::__is_growable) {
             this->__ensure_capacity(new_cap, _size);
         }
 
     private:
+        // Shift [pos, end()) up one step, leaving pos uninitialized.
+        __forceinline void relocate_up(iterator pos) {
+            memmove(static_cast<void*>(pos + 1), static_cast<const void*>(pos), (end() - pos) * sizeof(Type));
+        }
         int _size;
     };
-    
+
+    /**
+     `small_vector_c` is a `vector_c` with Count inline elements, that
+     transparently spills to dynamically allocated backing store when it
+     outgrows them. Use for vectors that are almost always tiny, but
+     occasionally large.
+     */
+    template<class Type, int Count>
+    using small_vector_c = vector_c<Type, Count, detail::base_buffer_small_c<Type, Count>>;
+
 }
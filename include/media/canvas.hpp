@@ -125,7 +125,7 @@ namespace toybox {
         dirtymap_c* _dirtymap = nullptr;
         const stencil_t* _stencil = nullptr;
         rect_s _clip_rect;
-        uint16_t _tileset_line_words;
+        uint16_t _tileset_line_words = 0;
         bool _clipping = true;
         
         void imp_fill(uint8_t ci, const rect_s& rect) const;
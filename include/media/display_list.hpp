@@ -7,7 +7,7 @@
 
 #pragma once
 
-#include "core/list.hpp"
+#include "core/intrusive_list.hpp"
 #include "core/memory.hpp"
 
 namespace toybox {
@@ -29,7 +29,9 @@ namespace toybox {
         PRIMARY_VIEWPORT = -1,
         PRIMARY_PALETTE = -2
     };
-    struct display_list_entry_s {
+    struct display_list_entry_s : public intrusive_list_node_s<display_list_entry_s> {
+        display_list_entry_s(int id, int row, const shared_ptr_c<display_item_c>& item_ptr) :
+            id(id), row(row), item_ptr(item_ptr) {}
         int id;
         int row;
         shared_ptr_c<display_item_c> item_ptr;
@@ -76,19 +78,64 @@ namespace toybox {
         __forceinline bool operator<(const display_list_entry_s& rhs) const {
             return row < rhs.row;
         }
+        void* operator new(size_t count) {
+            assert(allocator::alloc_size >= count && "Allocation size exceeds allocator capacity");
+            return allocator::allocate();
+        }
+        void operator delete(void* ptr) {
+            allocator::deallocate(ptr);
+        }
+        using allocator = pool_allocator_c<display_list_entry_s, 16>;
     };
     
-    class display_list_c : public list_c<display_list_entry_s> {
+    /**
+     A display list is a list of viewports and palettes sorted by row.
+     Entries are owned by the list, and linked intrusively so that the VBL
+     can walk the list, and entries can be removed in O(1).
+     */
+    class display_list_c : public nocopy_c {
     public:
-        ~display_list_c() = default;
+        using value_type = display_list_entry_s;
+        using reference = value_type&;
+        using const_reference = const value_type&;
+        using entry_list_c = intrusive_list_c<display_list_entry_s>;
+        using iterator = entry_list_c::iterator;
+        using const_iterator = entry_list_c::const_iterator;
+
+        display_list_c() = default;
+        ~display_list_c() { clear(); }
+
+        __forceinline iterator begin() __pure { return _entries.begin(); }
+        __forceinline const_iterator begin() const __pure { return _entries.begin(); }
+        __forceinline iterator end() __pure { return _entries.end(); }
+        __forceinline const_iterator end() const __pure { return _entries.end(); }
+        __forceinline bool empty() const __pure { return _entries.empty(); }
+        __forceinline int size() const __pure { return _entries.size(); }
+
+        template<class ...Args>
+        reference emplace_front(Args&& ...args) {
+            auto entry = new display_list_entry_s(forward<Args>(args)...);
+            _entries.push_front(*entry);
+            return *entry;
+        }
         const_iterator insert_sorted(const_reference value) {
-            auto pos = iterator_before(value.row);
-            return insert_after(pos, value);
+            return _entries.insert(insert_position(value.row), *new display_list_entry_s(value));
         }
         template<class ...Args>
         iterator emplace_sorted(int id, int row, Args&& ...args) {
-            auto pos = iterator_before(row);
-            return emplace_after(pos, id, row, forward<Args>(args)...);
+            auto entry = new display_list_entry_s(id, row, forward<Args>(args)...);
+            return _entries.insert(insert_position(row), *entry);
+        }
+        /// Removes and destroys entry, O(1) operation.
+        iterator erase(reference entry) {
+            auto next = _entries.erase(entry);
+            delete &entry;
+            return next;
+        }
+        void clear() {
+            while (!_entries.empty()) {
+                erase(_entries.front());
+            }
         }
 
         __forceinline display_list_entry_s& get(int id) const {
@@ -103,17 +150,15 @@ namespace toybox {
         }
 
     private:
-        const_iterator iterator_before(int row) const {
-            auto iter = before_begin();
-            while (iter._node->next) {
-                if (iter._node->next->value.row >= row) {
-                    break;
-                }
+        // First entry with row not less than row, new entries are inserted before it.
+        const_iterator insert_position(int row) const {
+            auto iter = begin();
+            while (iter != end() && iter->row < row) {
                 ++iter;
             }
             return iter;
         }
-        
+        entry_list_c _entries;
     };
-    
+
 }
@@ -11,6 +11,7 @@
 #include "core/memory.hpp"
 #include "runtime/assets.hpp"
 #include "core/iffstream.hpp"
+#include "core/span.hpp"
 
 namespace toybox {
     
@@ -33,7 +34,7 @@ namespace toybox {
             none,
             packbits,
             vertical,  // Not supported
-            deflate    // Non-standard, not supported as of now
+            deflate    // Non-standard, zlib stream, if TOYBOX_ILBM_SUPPORTS_DEFLATE
         };
         static constexpr int MASKED_CIDX = -1;
         static __forceinline constexpr bool is_masked(int i) __pure { return i < 0; }
@@ -63,6 +64,16 @@ namespace toybox {
 
         int get_pixel(point_s at) const;
         void put_pixel(int ci, point_s) const;
+
+        /// Returns a view of bitmap words, each row has four interweaved bitplane words per 16 pixels.
+        __forceinline span2d_c<uint16_t> bitmap_span() const {
+            return span2d_c<uint16_t>(_bitmap.get(), _line_words << 2, _size.height, _line_words << 2);
+        }
+        /// Returns a view of maskmap words, or an empty view if not masked.
+        __forceinline span2d_c<uint16_t> maskmap_span() const {
+            if (_maskmap == nullptr) return span2d_c<uint16_t>();
+            return span2d_c<uint16_t>(_maskmap, _line_words, _size.height, _line_words);
+        }
         
     private:
         int imp_get_pixel(point_s at) const;
@@ -12,6 +12,7 @@
 #include "core/memory.hpp"
 #include "core/concepts.hpp"
 #include "core/bitset.hpp"
+#include "core/inplace_function.hpp"
 
 namespace toybox {
 
@@ -32,27 +33,57 @@ namespace toybox {
     class sound_c;
     class music_c;
     class tilemap_level_c;
+    class pack_c;
+
+    namespace detail {
+        class asset_loader_c;
+    }
 
     /**
      `asset_manager_c` handles loading and unloading of assets from disk.
      The asset manager is a singleton, intended for subclassing for each client
      of toybox.
      The client is expected to set the singleton.
+     Assets are loaded synchronously by `preload()` and on first access, or
+     in the background with `request()` and `update()`.
+     Assets are read from individual files in the data directory, or from a
+     single pack file opened once with `open_pack()`.
      */
     class asset_manager_c final : nocopy_c {
     public:
         using asset_set_t = bitset_c<uint16_t>;
         static asset_manager_c& shared();
         
-        ~asset_manager_c() {}
+        ~asset_manager_c();
+
+        using progress_f = inplace_function_c<void(int loaded, int total)>;
+        /**
+         Opens and mounts a `pack_c` in the data directory, assets in the pack
+         are then read from it instead of opening individual files. Returns
+         false if the pack could not be opened, assets are then read from files.
+         */
+        bool open_pack(const char* file);
 
-        using progress_f = void(*)(int loaded, int total);
-        void preload(asset_set_t sets, progress_f progress = nullptr);
+        void preload(asset_set_t sets, const progress_f& progress = nullptr);
         void unload(asset_set_t sets);
 
         asset_c& asset(int id) const;
         void unload(int id);
 
+        static constexpr size_t default_update_budget = 2048;
+
+        /// Queues all not yet loaded assets in sets for loading by `update()`.
+        void request(asset_set_t sets);
+        /**
+         Advances loading of requested assets, called once per frame by the
+         `scene_manager_c` run loop. Files are read by a background thread on host, and at most
+         budget bytes per call on target. Assets are constructed from the read
+         file on the calling thread. Returns true when all requests are done.
+         */
+        bool update(size_t budget = default_update_budget);
+        __forceinline bool ready(int id) const { return _assets[id].get() != nullptr; }
+        bool ready(asset_set_t sets) const;
+
         template<derived_from<asset_c> T>
         __forceinline T& asset(int id) const { return (T&)(asset(id)); };
 
@@ -99,10 +130,17 @@ namespace toybox {
 
     private:
         asset_manager_c();
-        asset_c* create_asset(int id, const asset_def_s& def) const;
+        void create(int id, const char* path) const;
+        asset_c* create_asset(int id, const asset_def_s& def, const char* path) const;
+        bool start_load();
+        void finish_load() const;
 
         vector_c<asset_def_s, 0> _asset_defs;
         mutable vector_c<unique_ptr_c<asset_c>, 0> _assets;
+        vector_c<int16_t, 0> _requests;
+        unique_ptr_c<pack_c> _pack;
+        unique_ptr_c<detail::asset_loader_c> _loader;
+        mutable unique_ptr_c<char> _load_path;
     };
     
 }
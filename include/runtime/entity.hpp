@@ -15,7 +15,17 @@
 
 namespace toybox {
 
+    /// Coordinate type of entity positions, see `TOYBOX_ENTITY_FIX32`.
+#if TOYBOX_ENTITY_FIX32
+    using entity_coord_t = fix32_t;
+#else
+    using entity_coord_t = fix16_t;
+#endif
+
     struct entity_s {
+        using coord_t = entity_coord_t;
+        using point_t = base_point_s<coord_t>;
+        using rect_t = base_rect_s<coord_t>;
         uint8_t id = 0;
 #if __M68000__
         uint8_t active :1 = 1;  // Only active entities are drawn, run and actions.
@@ -30,22 +40,33 @@ namespace toybox {
         uint8_t group = 0;
         uint8_t action = 0;
         uint8_t frame_index = 0;
-        frect_s position;
+#if TOYBOX_ENTITY_FIX32
+        uint16_t reserved_align = 0;  // Keeps position long aligned on host
+        rect_t position;
+        uint16_t reserved_data[4];
+#else
+        rect_t position;
         uint16_t reserved_data[5];
-        template<class T> requires (sizeof(T) <= 10)
+#endif
+        template<class T> requires (sizeof(T) <= sizeof(reserved_data))
         T& data_as() { return (T&)(reserved_data[0]); }
-        template<class T> requires (sizeof(T) <= 10)
+        template<class T> requires (sizeof(T) <= sizeof(reserved_data))
         const T& data_as() const { return (const T&)(reserved_data[0]); }
     };
     static_assert((offsetof(entity_s, reserved_data) & 1) == 0);
-    static_assert(sizeof(entity_s) == 24);
+    static_assert(sizeof(entity_s) == (TOYBOX_ENTITY_FIX32 ? 32 : 24));
+    static_assert(is_trivially_relocatable<entity_s>::value);
 
     using entity_pair_c = pair_c<int, entity_s>;
     
     // struct_layout for byte-order swapping
     template<>
     struct struct_layout<entity_s> {
+#if TOYBOX_ENTITY_FIX32
+        static constexpr const char* value = "6b1w4l8b";  // id, type, group, action, frame_index, flags, align, position(4l), data[8]
+#else
         static constexpr const char* value = "6b4w10b";  // id, type, group, action, frame_index, flags, position(4w), data[10]
+#endif
     };
 
     struct entity_type_def_s {
@@ -54,7 +75,7 @@ namespace toybox {
             rect_s rect;    // Rect of relative to graphics tile
         };
         tileset_c* tileset;  // Non-owning
-        vector_c<frame_def_s, 0> frame_defs;
+        small_vector_c<frame_def_s, 4> frame_defs;
     };
     
 }
@@ -12,6 +12,7 @@
 #include "media/viewport.hpp"
 #include "media/display_list.hpp"
 #include "core/vector.hpp"
+#include "core/frame_arena.hpp"
 
 namespace toybox {
     
@@ -48,6 +49,7 @@ namespace toybox {
         virtual void will_appear(bool obscured) {};
         virtual void will_disappear(bool obscured) {};
         
+        /// Called once per frame, transient data may be allocated with `frame_arena_c`.
         virtual void update(display_list_c& display_list, int ticks) {};
 
     protected:
@@ -10,6 +10,7 @@
 #include "media/tileset.hpp"
 #include "runtime/entity.hpp"
 #include "core/system_helpers.hpp"
+#include "core/span.hpp"
 
 namespace toybox {
 
@@ -48,6 +49,8 @@ namespace toybox {
     };
     static_assert((offsetof(tile_s, reserved_data) & 1) == 0);
     static_assert(sizeof(tile_s) == 8);
+    template<>
+    struct is_trivially_relocatable<tile_s> : public true_type {};
     
     
     class tilemap_c : nocopy_c {
@@ -62,13 +65,16 @@ namespace toybox {
 
         __forceinline rect_s tilespace_bounds() const { return _tilespace_bounds; }
         
-        __forceinline vector_c<int8_t,0>& activate_entity_idxs() { return _activate_entity_idxs; };
+        __forceinline small_vector_c<int8_t,16>& activate_entity_idxs() { return _activate_entity_idxs; };
         __forceinline vector_c<tile_s, 0>& tiles() { return _tiles; };
+        /// Returns a 2D view of all tiles, in local tilespace.
+        __forceinline span2d_c<tile_s> tiles_span() { return span2d_c<tile_s>(_tiles.data(), _tilespace_bounds.size); }
+        __forceinline span2d_c<const tile_s> tiles_span() const { return span2d_c<const tile_s>(_tiles.data(), _tilespace_bounds.size); }
         
     protected:
         rect_s _tilespace_bounds;
         vector_c<tile_s, 0> _tiles;
-        vector_c<int8_t,0> _activate_entity_idxs;
+        small_vector_c<int8_t,16> _activate_entity_idxs;
     };
     
     // Shared file format structures for level editor and game runtime
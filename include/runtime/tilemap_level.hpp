@@ -7,6 +7,7 @@
 
 #pragma once
 
+#include "core/frame_arena.hpp"
 #include "core/span.hpp"
 #include "runtime/actions.hpp"
 #include "runtime/tilemap.hpp"
@@ -31,6 +32,7 @@ namespace toybox {
 
         const char* name() const { return _name.get(); }
         
+        /// Update and draw level, transient data may be allocated with `frame_arena_c`.
         virtual void update(viewport_c& viewport, int display_id, int ticks);
         bool is_initialized() const { return _is_initialized; }
         virtual void init();
@@ -45,11 +47,20 @@ namespace toybox {
             return *_viewport;
         };
 
+        /// Collision queries by point or rect take any coordinate type, rect queries against entities are
+        /// instantiated for `fix16_t` and `fix32_t`.
         tile_s::type_e collides_with_level(uint8_t id) const;
-        tile_s::type_e collides_with_level(fpoint_s at) const;
-        tile_s::type_e collides_with_level(const frect_s& rect) const;
+        template<class Coord>
+        __forceinline tile_s::type_e collides_with_level(base_point_s<Coord> at) const {
+            return tile_type_at(static_cast<point_s>(at));
+        }
+        template<class Coord>
+        __forceinline tile_s::type_e collides_with_level(const base_rect_s<Coord>& rect) const {
+            return max_tile_type_in(static_cast<rect_s>(rect));
+        }
         bool collides_with_entity(uint8_t id, uint8_t in_group, uint8_t* id_out) const;
-        bool collides_with_entity(const frect_s& rect, uint8_t in_group, uint8_t* id_out) const;
+        template<class Coord>
+        bool collides_with_entity(const base_rect_s<Coord>& rect, uint8_t in_group, uint8_t* id_out) const;
 
         pair_c<int, action_f> add_action(action_f action);
         span_c<action_f> actions() { return {_actions.begin(), _actions.size()}; };
@@ -59,7 +70,7 @@ namespace toybox {
         span_c<entity_type_def_s> entity_type_defs() { return {_entity_type_defs.begin(), _entity_type_defs.size()}; };
         span_c<const entity_type_def_s> entity_type_defs() const { return {_entity_type_defs.begin(), _entity_type_defs.size()}; };
 
-        entity_s& spawn_entity(uint8_t type, uint8_t group, frect_s position);
+        entity_s& spawn_entity(uint8_t type, uint8_t group, entity_s::rect_t position);
         entity_s& entity_at(uint8_t id);
         const entity_s& entity_at(uint8_t id) const;
         span_c<entity_s> all_entities() { return {_all_entities.begin(), _all_entities.size()}; }
@@ -93,6 +104,9 @@ namespace toybox {
         virtual void splice_entity(entity_s& entity);
         
     private:
+        tile_s::type_e tile_type_at(point_s pixel_at) const;
+        tile_s::type_e max_tile_type_in(const rect_s& pixel_rect) const;
+
         viewport_c* _viewport;  // Non-owning, valid only during update() call
         unique_ptr_c<dirtymap_c> _tiles_dirtymap;
         rect_s _visible_bounds;
@@ -129,11 +143,28 @@ namespace toybox {
         };
         static_assert((offsetof(level_header_s, reserved_data) & 1) == 0);
         static_assert(sizeof(level_header_s) == 16);
+#if TOYBOX_ENTITY_FIX32
+        // Entity record for ENTS chunk, always with fix16_t positions, widened when loaded
+        struct entity_record_s {
+            uint8_t fields[6];          // id, flags, type, group, action and frame_index as in entity_s
+            frect_s position;
+            uint16_t reserved_data[5];  // Only the first 4 fit in entity_s
+        };
+#else
+        using entity_record_s = entity_s;
+#endif
+        static_assert(sizeof(entity_record_s) == 24);
     }
     // struct_layout for byte-order swapping
     template<>
     struct struct_layout<detail::level_header_s> {
         static constexpr const char* value = "2w2b";  // size.width, size.height, tileset_index, entity_count
     };
+#if TOYBOX_ENTITY_FIX32
+    template<>
+    struct struct_layout<detail::entity_record_s> {
+        static constexpr const char* value = "6b4w10b";  // fields, position(4w), data[10]
+    };
+#endif
 
 }
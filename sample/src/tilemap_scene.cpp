@@ -27,7 +27,7 @@ enum player_frame_index {
     UP, DOWN, LEFT, RIGHT
 };
 
-static bool move_entity_if_possible(tilemap_level_c& level, entity_s& entity, fpoint_s delta) {
+static bool move_entity_if_possible(tilemap_level_c& level, entity_s& entity, entity_s::point_t delta) {
     // Move entity, if not posissible we adjust back on exit
     entity.position.origin = entity.position.origin + delta;
     // Collision with level is always fail
@@ -48,7 +48,7 @@ static bool move_entity_if_possible(tilemap_level_c& level, entity_s& entity, fp
 
 static void player_control(tilemap_level_c& level, entity_s& entity, bool event) {
     auto dir = controller_c::shared().directions();
-    fpoint_s delta(0,0);
+    entity_s::point_t delta(0,0);
     if ((dir & controller_c::up) == true) {
         delta.y -= 1;
         entity.frame_index = UP;
@@ -63,7 +63,7 @@ static void player_control(tilemap_level_c& level, entity_s& entity, bool event)
         delta.x += 1;
         entity.frame_index = RIGHT;
     }
-    if (delta != fpoint_s()) {
+    if (delta != entity_s::point_t()) {
         move_entity_if_possible(level, entity, delta);
     }
     point_s offset((int16_t)entity.position.origin.x - 160 + 8, 0);
@@ -108,7 +108,7 @@ tilemap_level_c* create_tilemaplevel() {
         for (int x = 0; x < size.width; x++) {
             auto& tile = level[x,y];
             auto origin = [&]() {
-                return fpoint_s(x * 16, y * 16);
+                return entity_s::point_t(x * 16, y * 16);
             };
             switch (line[x]) {
                 case ' ':
@@ -127,14 +127,14 @@ tilemap_level_c* create_tilemaplevel() {
                     break;
                 case '@': {
                     tile.index = FLOOR;
-                    auto& player = level.spawn_entity(PLAYER, PLAYER, frect_s{ origin() + fpoint_s(2,2), {12,12} });
+                    auto& player = level.spawn_entity(PLAYER, PLAYER, entity_s::rect_t{ origin() + entity_s::point_t(2,2), {12,12} });
                     player.action = 1;
                     player.frame_index = DOWN;
                     break;
                 }
                 case '$': {
                     tile.index = FLOOR;
-                    auto& box = level.spawn_entity(BOX, BOX, frect_s{ origin(), {16,16} });
+                    auto& box = level.spawn_entity(BOX, BOX, entity_s::rect_t{ origin(), {16,16} });
                     break;
                 }
                 default:
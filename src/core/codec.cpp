@@ -0,0 +1,113 @@
+//
+//  codec.cpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "core/codec.hpp"
+
+using namespace toybox;
+using namespace toybox::detail;
+
+size_t codec_stream_c::write(const uint8_t* buf, size_t count) {
+    assert(false && "Decompressing streams are read only");
+    return 0;
+}
+
+bool codec_stream_c::refill() {
+    _in_ptr = _in;
+    _in_end = _in + _stream.read(_in, sizeof(_in));
+    return _in_ptr != _in_end;
+}
+
+bool codec_stream_c::skip(size_t count) {
+    uint8_t skip[64];
+    while (count) {
+        const size_t n = read(skip, MIN(count, sizeof(skip)));
+        if (n == 0) {
+            return false;
+        }
+        count -= n;
+    }
+    return true;
+}
+
+#ifndef __M68000__
+
+void byte_writer_c::put_bytes(const uint8_t* buf, size_t count) {
+    while (count--) {
+        put_byte(*buf++);
+    }
+}
+
+size_t byte_writer_c::finish() {
+    flush();
+    return _failed ? 0 : _written;
+}
+
+void byte_writer_c::flush() {
+    if (_stream.write(_buffer, _used) != _used) {
+        _failed = true;
+    }
+    _written += _used;
+    _used = 0;
+}
+
+lz_matcher_c::lz_matcher_c(const uint8_t* data, size_t len, int window_bits, int32_t max_dist, int min_match, int32_t max_match, int max_chain) :
+    _data(data), _end(static_cast<int32_t>(len)), _window_mask((static_cast<int32_t>(1) << window_bits) - 1),
+    _max_dist(max_dist), _max_match(max_match), _min_match(min_match), _max_chain(max_chain), _hashed(0),
+    _head(static_cast<int32_t*>(_malloc(sizeof(int32_t) << hash_bits))),
+    _prev(static_cast<int32_t*>(_malloc(sizeof(int32_t) * (_window_mask + 1))))
+{
+    assert(min_match <= 4 && "Hash covers at most 4 bytes");
+    if (_head) {
+        memset(_head, 0xff, sizeof(int32_t) << hash_bits);
+    }
+}
+
+lz_matcher_c::~lz_matcher_c() {
+    _free(_head);
+    _free(_prev);
+}
+
+int32_t lz_matcher_c::find(int32_t pos, int32_t& dist) {
+    // Insert all positions up to pos, so matches never start at pos itself.
+    for (; _hashed < pos && _hashed + _min_match <= _end; ++_hashed) {
+        const int h = hash_at(_data + _hashed);
+        _prev[_hashed & _window_mask] = _head[h];
+        _head[h] = _hashed;
+    }
+    const int32_t limit = MIN(_max_match, _end - pos);
+    if (limit < _min_match) {
+        return 0;
+    }
+    const uint8_t* p = _data + pos;
+    int32_t best = 0;
+    int32_t candidate = _head[hash_at(p)];
+    for (int chain = _max_chain; candidate >= 0 && pos - candidate <= _max_dist && chain; --chain) {
+        const uint8_t* q = _data + candidate;
+        if (q[best] == p[best]) {
+            int32_t n = 0;
+            while (n < limit && q[n] == p[n]) {
+                n++;
+            }
+            if (n > best) {
+                best = n;
+                dist = pos - candidate;
+                if (n == limit) {
+                    break;
+                }
+            }
+        }
+        // Ring entries overwritten by later positions end the chain.
+        const int32_t next = _prev[candidate & _window_mask];
+        if (next >= candidate) {
+            break;
+        }
+        candidate = next;
+    }
+    return best >= _min_match ? best : 0;
+}
+
+#endif
@@ -7,6 +7,8 @@
 
 #include "core/cincludes.hpp"
 #include "core/memory.hpp"
+#include "core/slab_allocator.hpp"
+#include "core/memory_telemetry.hpp"
 #include <errno.h>
 
 extern "C" {
@@ -28,11 +30,34 @@ extern "C" {
     };
 }
 
+static __forceinline void* new_alloc(size_t n) {
+#if TOYBOX_SLAB_ALLOCATOR
+    void* p = toybox::slab_allocator_c::allocate(n);
+#else
+    void* p = _malloc(n);
+#endif
+#if TOYBOX_MEMORY_TELEMETRY
+    toybox::memory_telemetry_c::did_allocate(p, n);
+#endif
+    return p;
+}
+
+static __forceinline void new_free(void* p) {
+#if TOYBOX_MEMORY_TELEMETRY
+    toybox::memory_telemetry_c::did_deallocate(p);
+#endif
+#if TOYBOX_SLAB_ALLOCATOR
+    toybox::slab_allocator_c::deallocate(p);
+#else
+    _free(p);
+#endif
+}
+
 void* operator new (size_t n) {
-    return _malloc(n);
+    return new_alloc(n);
 }
 void* operator new[] (size_t n) {
-    return _malloc(n);
+    return new_alloc(n);
 }
 
 #if __clang__
@@ -40,16 +65,16 @@ void* operator new[] (size_t n) {
 #pragma GCC diagnostic ignored "-Wimplicit-exception-spec-mismatch"
 #endif
 void operator delete (void* p) {
-    _free(p);
+    new_free(p);
 }
 void operator delete (void* p, size_t) { // ≥C++14
-    _free(p);
+    new_free(p);
 }
 void operator delete[] (void* p) {
-    _free(p);
+    new_free(p);
 }
 void operator delete[] (void* p, size_t) { // ≥C++14
-    _free(p);
+    new_free(p);
 }
 #if __clang__
 #pragma GCC diagnostic pop
@@ -0,0 +1,719 @@
+//
+//  deflate.cpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "core/deflate.hpp"
+
+using namespace toybox;
+
+static const uint16_t s_length_base[29] = {
+    3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+    35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258
+};
+static const uint8_t s_length_extra[29] = {
+    0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+    3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0
+};
+static const uint16_t s_dist_base[30] = {
+    1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+    257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145, 8193, 12289, 16385, 24577
+};
+static const uint8_t s_dist_extra[30] = {
+    0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+    7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13
+};
+static const uint8_t s_code_length_order[19] = {
+    16, 17, 18, 0, 8, 7, 9, 6, 10, 5, 11, 4, 12, 3, 13, 2, 14, 1, 15
+};
+
+/// Adler-32 of data continued from adler, start from 1 for a new checksum.
+static uint32_t adler32(uint32_t adler, const uint8_t* data, size_t len) {
+    static constexpr uint32_t base = 65521;
+    uint32_t a = adler & 0xffff;
+    uint32_t b = adler >> 16;
+    while (len) {
+        // Largest run that can not overflow b before the modulo.
+        size_t n = MIN(len, static_cast<size_t>(5552));
+        len -= n;
+        while (n--) {
+            a += *data++;
+            b += a;
+        }
+        a %= base;
+        b %= base;
+    }
+    return (b << 16) | a;
+}
+
+static uint16_t bit_reverse(uint16_t v, int bits) {
+    v = static_cast<uint16_t>(((v & 0xaaaa) >> 1) | ((v & 0x5555) << 1));
+    v = static_cast<uint16_t>(((v & 0xcccc) >> 2) | ((v & 0x3333) << 2));
+    v = static_cast<uint16_t>(((v & 0xf0f0) >> 4) | ((v & 0x0f0f) << 4));
+    v = static_cast<uint16_t>((v >> 8) | (v << 8));
+    return v >> (16 - bits);
+}
+
+bool detail::inflate_huffman_s::build(const uint8_t* code_lengths, int count) {
+    uint16_t counts[16] = { 0 };
+    uint16_t next_code[16];
+    memset(fast, 0, sizeof(fast));
+    for (int i = 0; i < count; ++i) {
+        counts[code_lengths[i]]++;
+    }
+    counts[0] = 0;
+    uint32_t code = 0;
+    uint16_t symbol = 0;
+    for (int len = 1; len < 16; ++len) {
+        next_code[len] = static_cast<uint16_t>(code);
+        first_code[len] = static_cast<uint16_t>(code);
+        first_symbol[len] = symbol;
+        code += counts[len];
+        if (counts[len] && code - 1 >= (static_cast<uint32_t>(1) << len)) {
+            return false; // Over subscribed
+        }
+        max_code[len] = code << (16 - len);
+        code <<= 1;
+        symbol += counts[len];
+    }
+    max_code[16] = 0x10000;
+    for (int i = 0; i < count; ++i) {
+        const int len = code_lengths[i];
+        if (len) {
+            const int c = next_code[len] - first_code[len] + first_symbol[len];
+            lengths[c] = static_cast<uint8_t>(len);
+            symbols[c] = static_cast<uint16_t>(i);
+            if (len <= fast_bits) {
+                const uint16_t value = static_cast<uint16_t>((len << fast_bits) | i);
+                for (uint16_t j = bit_reverse(next_code[len], len); j < (1 << fast_bits); j += (1 << len)) {
+                    fast[j] = value;
+                }
+            }
+            next_code[len]++;
+        }
+    }
+    return true;
+}
+
+inflate_stream_c::inflate_stream_c(stream_c& stream) :
+    codec_stream_c(stream), _pad_bits(0),
+    _bits(0), _bit_count(0), _state(state_e::header), _final(false), _truncated(false),
+    _tables(nullptr), _window(nullptr), _window_mask(0), _window_pos(0),
+    _stored_left(0), _match_left(0), _match_dist(0), _adler(1), _pos(0)
+{}
+
+inflate_stream_c::~inflate_stream_c() {
+    if (_tables) {
+        _free(_tables);
+    }
+}
+
+bool inflate_stream_c::good() const { return _state != state_e::error; }
+
+ptrdiff_t inflate_stream_c::tell() const {
+    return _state == state_e::error ? -1 : _pos;
+}
+
+ptrdiff_t inflate_stream_c::seek(ptrdiff_t pos, seekdir_e way) {
+    switch (way) {
+        case seekdir_e::beg:
+            pos -= _pos;
+            break;
+        case seekdir_e::cur:
+            break;
+        default:
+            return -1;
+    }
+    if (pos < 0 || !skip(pos)) {
+        return -1;
+    }
+    return tell();
+}
+
+void inflate_stream_c::fill_bits() {
+    while (_bit_count <= 24) {
+        uint8_t byte = 0;
+        if (!get_byte(byte)) {
+            // Pad with zeros past the end of input, an error only if consumed.
+            _pad_bits += 8;
+        }
+        _bits |= static_cast<uint32_t>(byte) << _bit_count;
+        _bit_count += 8;
+    }
+}
+
+uint16_t inflate_stream_c::get_bits(int count) {
+    if (_bit_count < count) {
+        fill_bits();
+    }
+    const uint16_t value = static_cast<uint16_t>(_bits & ((static_cast<uint32_t>(1) << count) - 1));
+    _bits >>= count;
+    _bit_count -= count;
+    check_truncated();
+    return value;
+}
+
+int16_t inflate_stream_c::decode(const detail::inflate_huffman_s& huffman) {
+    using huffman_s = detail::inflate_huffman_s;
+    if (_bit_count < 16) {
+        fill_bits();
+    }
+    const uint16_t fast = huffman.fast[_bits & ((1 << huffman_s::fast_bits) - 1)];
+    if (fast) {
+        const int len = fast >> huffman_s::fast_bits;
+        _bits >>= len;
+        _bit_count -= len;
+        check_truncated();
+        return static_cast<int16_t>(fast & ((1 << huffman_s::fast_bits) - 1));
+    }
+    const uint16_t code = bit_reverse(static_cast<uint16_t>(_bits), 16);
+    int len = huffman_s::fast_bits + 1;
+    while (len < 16 && code >= huffman.max_code[len]) {
+        len++;
+    }
+    if (len >= 16) {
+        return -1;
+    }
+    const int c = (code >> (16 - len)) - huffman.first_code[len] + huffman.first_symbol[len];
+    if (c >= huffman_s::max_symbols || huffman.lengths[c] != len) {
+        return -1;
+    }
+    _bits >>= len;
+    _bit_count -= len;
+    check_truncated();
+    return static_cast<int16_t>(huffman.symbols[c]);
+}
+
+bool inflate_stream_c::read_header() {
+    const uint16_t cmf = get_bits(8);
+    const uint16_t flg = get_bits(8);
+    if ((cmf & 0x0f) != 8 || (cmf >> 4) > 7 || (flg & 0x20) != 0 || ((cmf << 8) | flg) % 31 != 0) {
+        return false; // Not deflate, too large window, preset dictionary or bad check
+    }
+    const uint16_t window_size = static_cast<uint16_t>(1 << ((cmf >> 4) + 8));
+    _tables = static_cast<tables_s*>(_malloc(sizeof(tables_s) + window_size));
+    if (_tables == nullptr) {
+        return false;
+    }
+    _window = reinterpret_cast<uint8_t*>(_tables + 1);
+    _window_mask = window_size - 1;
+    return true;
+}
+
+bool inflate_stream_c::read_block_header() {
+    _final = get_bits(1);
+    switch (get_bits(2)) {
+        case 0: {
+            // Stored, drop bits to the byte boundary
+            get_bits(_bit_count & 7);
+            const uint16_t len = get_bits(16);
+            const uint16_t nlen = get_bits(16);
+            if (static_cast<uint16_t>(~nlen) != len) {
+                return false;
+            }
+            _stored_left = len;
+            _state = state_e::stored;
+            return true;
+        }
+        case 1: {
+            uint8_t lengths[detail::inflate_huffman_s::max_symbols];
+            memset(lengths, 8, 144);
+            memset(lengths + 144, 9, 112);
+            memset(lengths + 256, 7, 24);
+            memset(lengths + 280, 8, 8);
+            _tables->litlen.build(lengths, 288);
+            memset(lengths, 5, 30);
+            _tables->dist.build(lengths, 30);
+            _state = state_e::codes;
+            return true;
+        }
+        case 2:
+            if (!read_dynamic_tables()) {
+                return false;
+            }
+            _state = state_e::codes;
+            return true;
+        default:
+            return false;
+    }
+}
+
+bool inflate_stream_c::read_dynamic_tables() {
+    const int hlit = get_bits(5) + 257;
+    const int hdist = get_bits(5) + 1;
+    const int hclen = get_bits(4) + 4;
+    if (hlit > 286 || hdist > 30) {
+        return false;
+    }
+    uint8_t lengths[286 + 30];
+    memset(lengths, 0, 19);
+    for (int i = 0; i < hclen; ++i) {
+        lengths[s_code_length_order[i]] = static_cast<uint8_t>(get_bits(3));
+    }
+    // Code length codes are decoded with the distance table, it is rebuilt below.
+    auto& code_lengths = _tables->dist;
+    if (!code_lengths.build(lengths, 19)) {
+        return false;
+    }
+    int n = 0;
+    while (n < hlit + hdist) {
+        const int16_t symbol = decode(code_lengths);
+        int repeat;
+        uint8_t value = 0;
+        if (symbol < 0) {
+            return false;
+        } else if (symbol < 16) {
+            lengths[n++] = static_cast<uint8_t>(symbol);
+            continue;
+        } else if (symbol == 16) {
+            if (n == 0) {
+                return false;
+            }
+            value = lengths[n - 1];
+            repeat = 3 + get_bits(2);
+        } else if (symbol == 17) {
+            repeat = 3 + get_bits(3);
+        } else {
+            repeat = 11 + get_bits(7);
+        }
+        if (n + repeat > hlit + hdist) {
+            return false;
+        }
+        memset(lengths + n, value, repeat);
+        n += repeat;
+    }
+    if (lengths[256] == 0) {
+        return false; // No end of block code
+    }
+    return _tables->litlen.build(lengths, hlit) && _tables->dist.build(lengths + hlit, hdist);
+}
+
+bool inflate_stream_c::read_trailer() {
+    // Adler-32 of the uncompressed data, big endian from the next byte boundary.
+    get_bits(_bit_count & 7);
+    uint32_t adler = 0;
+    for (int i = 0; i < 4; ++i) {
+        adler = (adler << 8) | get_bits(8);
+    }
+    return adler == _adler;
+}
+
+size_t inflate_stream_c::read(uint8_t* buf, size_t count) {
+    size_t done = 0;
+    size_t summed = 0;
+    while (done < count && _state != state_e::done && _state != state_e::error) {
+        switch (_state) {
+            case state_e::header:
+                _state = read_header() ? state_e::block : state_e::error;
+                break;
+            case state_e::block:
+                if (_final) {
+                    _adler = adler32(_adler, buf + summed, done - summed);
+                    summed = done;
+                    _state = read_trailer() ? state_e::done : state_e::error;
+                } else if (!read_block_header()) {
+                    _state = state_e::error;
+                }
+                break;
+            case state_e::stored:
+                while (_stored_left && done < count) {
+                    const uint8_t byte = static_cast<uint8_t>(get_bits(8));
+                    if (_truncated) {
+                        break;
+                    }
+                    _window[_window_pos] = byte;
+                    _window_pos = (_window_pos + 1) & _window_mask;
+                    buf[done++] = byte;
+                    _stored_left--;
+                }
+                if (_stored_left == 0) {
+                    _state = state_e::block;
+                }
+                break;
+            case state_e::codes:
+                while (done < count) {
+                    if (_match_left) {
+                        uint16_t n = static_cast<uint16_t>(MIN(static_cast<size_t>(_match_left), count - done));
+                        _match_left -= n;
+                        uint16_t from = (_window_pos - _match_dist) & _window_mask;
+                        while (n--) {
+                            const uint8_t byte = _window[from];
+                            from = (from + 1) & _window_mask;
+                            _window[_window_pos] = byte;
+                            _window_pos = (_window_pos + 1) & _window_mask;
+                            buf[done++] = byte;
+                        }
+                        continue;
+                    }
+                    int16_t symbol = decode(_tables->litlen);
+                    if (_truncated) {
+                        break;
+                    } else if (symbol < 256) {
+                        if (symbol < 0) {
+                            _state = state_e::error;
+                            break;
+                        }
+                        _window[_window_pos] = static_cast<uint8_t>(symbol);
+                        _window_pos = (_window_pos + 1) & _window_mask;
+                        buf[done++] = static_cast<uint8_t>(symbol);
+                    } else if (symbol == 256) {
+                        _state = state_e::block;
+                        break;
+                    } else {
+                        symbol -= 257;
+                        if (symbol >= 29) {
+                            _state = state_e::error;
+                            break;
+                        }
+                        const uint16_t length = s_length_base[symbol] + get_bits(s_length_extra[symbol]);
+                        symbol = decode(_tables->dist);
+                        if (_truncated) {
+                            break;
+                        } else if (symbol < 0 || symbol >= 30) {
+                            _state = state_e::error;
+                            break;
+                        }
+                        const uint32_t dist = s_dist_base[symbol] + get_bits(s_dist_extra[symbol]);
+                        if (_truncated) {
+                            break;
+                        } else if (dist > static_cast<uint32_t>(_window_mask) + 1 || dist > _pos + done) {
+                            _state = state_e::error;
+                            break;
+                        }
+                        _match_left = length;
+                        _match_dist = static_cast<uint16_t>(dist);
+                    }
+                }
+                break;
+            case state_e::done:
+            case state_e::error:
+                break;
+        }
+        if (_truncated) {
+            // Input ran out, only bytes decoded before that are returned.
+            _state = state_e::error;
+        }
+    }
+    _adler = adler32(_adler, buf + summed, done - summed);
+    _pos += done;
+    return done;
+}
+
+#ifndef __M68000__
+
+namespace {
+
+    constexpr int max_code_bits = 15;
+    constexpr int max_code_length_bits = 7;
+    constexpr int min_match = 3;
+    constexpr int max_match = 258;
+    constexpr int max_chain = 128;
+    constexpr int block_tokens = 16384;
+
+    struct token_s {
+        uint16_t value;     // Literal byte, or match length
+        uint16_t dist;      // 0 for literals
+    };
+
+    class bit_writer_c : public detail::byte_writer_c {
+    public:
+        bit_writer_c(stream_c& stream) : byte_writer_c(stream), _bits(0), _bit_count(0) {}
+
+        void put_bits(uint32_t value, int count) {
+            _bits |= value << _bit_count;
+            _bit_count += count;
+            while (_bit_count >= 8) {
+                put_byte(static_cast<uint8_t>(_bits));
+                _bits >>= 8;
+                _bit_count -= 8;
+            }
+        }
+        void align() {
+            if (_bit_count) {
+                put_bits(0, 8 - _bit_count);
+            }
+        }
+        size_t finish() {
+            align();
+            return byte_writer_c::finish();
+        }
+
+    private:
+        uint32_t _bits;
+        int _bit_count;
+    };
+
+    /// Huffman code lengths for frequencies, no longer than limit bits.
+    void build_lengths(const uint32_t* freqs, int count, int limit, uint8_t* lengths) {
+        uint32_t weights[2 * detail::inflate_huffman_s::max_symbols];
+        int16_t parents[2 * detail::inflate_huffman_s::max_symbols];
+        uint32_t scaled[detail::inflate_huffman_s::max_symbols];
+        memcpy(scaled, freqs, count * sizeof(uint32_t));
+        memset(lengths, 0, count);
+        int used = 0;
+        int last = 0;
+        for (int i = 0; i < count; ++i) {
+            if (freqs[i]) {
+                used++;
+                last = i;
+            }
+        }
+        if (used < 2) {
+            // A single code still needs one bit, give a second symbol a code to make the code complete.
+            lengths[last] = 1;
+            lengths[last == 0 ? 1 : 0] = 1;
+            return;
+        }
+        while (true) {
+            int nodes = count;
+            for (int i = 0; i < count; ++i) {
+                weights[i] = scaled[i];
+                parents[i] = scaled[i] ? 0 : -2;
+            }
+            // Repeatedly join the two lightest roots, parents of 0 mark roots.
+            for (int roots = used; roots > 1; --roots) {
+                int lo[2] = { -1, -1 };
+                for (int i = 0; i < nodes; ++i) {
+                    if (parents[i] != 0) {
+                        continue;
+                    }
+                    if (lo[0] < 0 || weights[i] < weights[lo[0]]) {
+                        lo[1] = lo[0];
+                        lo[0] = i;
+                    } else if (lo[1] < 0 || weights[i] < weights[lo[1]]) {
+                        lo[1] = i;
+                    }
+                }
+                weights[nodes] = weights[lo[0]] + weights[lo[1]];
+                parents[nodes] = 0;
+                parents[lo[0]] = parents[lo[1]] = static_cast<int16_t>(nodes);
+                nodes++;
+            }
+            int max_length = 0;
+            for (int i = 0; i < count; ++i) {
+                if (parents[i] < 0) {
+                    continue;
+                }
+                int length = 0;
+                for (int n = i; parents[n] != 0; n = parents[n]) {
+                    length++;
+                }
+                lengths[i] = static_cast<uint8_t>(length);
+                max_length = MAX(max_length, length);
+            }
+            if (max_length <= limit) {
+                return;
+            }
+            // Flatten the distribution and try again.
+            for (int i = 0; i < count; ++i) {
+                if (scaled[i]) {
+                    scaled[i] = (scaled[i] >> 1) | 1;
+                }
+            }
+        }
+    }
+
+    /// Canonical codes for lengths, bit reversed to be written LSB first.
+    void build_codes(const uint8_t* lengths, int count, uint16_t* codes) {
+        uint16_t counts[16] = { 0 };
+        uint16_t next_code[16];
+        for (int i = 0; i < count; ++i) {
+            counts[lengths[i]]++;
+        }
+        counts[0] = 0;
+        uint16_t code = 0;
+        for (int len = 1; len < 16; ++len) {
+            code = static_cast<uint16_t>((code + counts[len - 1]) << 1);
+            next_code[len] = code;
+        }
+        for (int i = 0; i < count; ++i) {
+            const int len = lengths[i];
+            codes[i] = len ? bit_reverse(next_code[len]++, len) : 0;
+        }
+    }
+
+    int length_symbol(int length) {
+        int i = 28;
+        while (s_length_base[i] > length) {
+            i--;
+        }
+        return i;
+    }
+
+    int dist_symbol(int dist) {
+        int i = 29;
+        while (s_dist_base[i] > dist) {
+            i--;
+        }
+        return i;
+    }
+
+    void write_block(bit_writer_c& out, const token_s* tokens, int count, bool final) {
+        uint32_t litlen_freqs[286] = { 0 };
+        uint32_t dist_freqs[30] = { 0 };
+        for (int i = 0; i < count; ++i) {
+            if (tokens[i].dist) {
+                litlen_freqs[257 + length_symbol(tokens[i].value)]++;
+                dist_freqs[dist_symbol(tokens[i].dist)]++;
+            } else {
+                litlen_freqs[tokens[i].value]++;
+            }
+        }
+        litlen_freqs[256] = 1;
+        uint8_t lengths[286 + 30];
+        uint8_t* dist_lengths = lengths + 286;
+        build_lengths(litlen_freqs, 286, max_code_bits, lengths);
+        build_lengths(dist_freqs, 30, max_code_bits, dist_lengths);
+        uint16_t litlen_codes[286];
+        uint16_t dist_codes[30];
+        build_codes(lengths, 286, litlen_codes);
+        build_codes(dist_lengths, 30, dist_codes);
+
+        int hlit = 286;
+        while (lengths[hlit - 1] == 0) {
+            hlit--;
+        }
+        int hdist = 30;
+        while (hdist > 1 && dist_lengths[hdist - 1] == 0) {
+            hdist--;
+        }
+        // Run length encode the code lengths of both tables as one sequence.
+        uint8_t all_lengths[286 + 30];
+        memcpy(all_lengths, lengths, hlit);
+        memcpy(all_lengths + hlit, dist_lengths, hdist);
+        const int total = hlit + hdist;
+        token_s runs[286 + 30];
+        int run_count = 0;
+        uint32_t cl_freqs[19] = { 0 };
+        for (int i = 0; i < total;) {
+            const uint8_t value = all_lengths[i];
+            int run = 1;
+            while (i + run < total && all_lengths[i + run] == value) {
+                run++;
+            }
+            i += run;
+            if (value == 0) {
+                while (run >= 11) {
+                    const int n = MIN(run, 138);
+                    runs[run_count++] = { 18, static_cast<uint16_t>(n - 11) };
+                    run -= n;
+                }
+                if (run >= 3) {
+                    runs[run_count++] = { 17, static_cast<uint16_t>(run - 3) };
+                    run = 0;
+                }
+            } else {
+                runs[run_count++] = { value, 0 };
+                run--;
+                while (run >= 3) {
+                    const int n = MIN(run, 6);
+                    runs[run_count++] = { 16, static_cast<uint16_t>(n - 3) };
+                    run -= n;
+                }
+            }
+            while (run-- > 0) {
+                runs[run_count++] = { value, 0 };
+            }
+        }
+        for (int i = 0; i < run_count; ++i) {
+            cl_freqs[runs[i].value]++;
+        }
+        uint8_t cl_lengths[19];
+        uint16_t cl_codes[19];
+        build_lengths(cl_freqs, 19, max_code_length_bits, cl_lengths);
+        build_codes(cl_lengths, 19, cl_codes);
+        int hclen = 19;
+        while (hclen > 4 && cl_lengths[s_code_length_order[hclen - 1]] == 0) {
+            hclen--;
+        }
+
+        out.put_bits(final ? 1 : 0, 1);
+        out.put_bits(2, 2);
+        out.put_bits(hlit - 257, 5);
+        out.put_bits(hdist - 1, 5);
+        out.put_bits(hclen - 4, 4);
+        for (int i = 0; i < hclen; ++i) {
+            out.put_bits(cl_lengths[s_code_length_order[i]], 3);
+        }
+        static const uint8_t s_run_extra[3] = { 2, 3, 7 };
+        for (int i = 0; i < run_count; ++i) {
+            const int symbol = runs[i].value;
+            out.put_bits(cl_codes[symbol], cl_lengths[symbol]);
+            if (symbol >= 16) {
+                out.put_bits(runs[i].dist, s_run_extra[symbol - 16]);
+            }
+        }
+        for (int i = 0; i < count; ++i) {
+            const token_s& token = tokens[i];
+            if (token.dist) {
+                const int ls = length_symbol(token.value);
+                out.put_bits(litlen_codes[257 + ls], lengths[257 + ls]);
+                out.put_bits(token.value - s_length_base[ls], s_length_extra[ls]);
+                const int ds = dist_symbol(token.dist);
+                out.put_bits(dist_codes[ds], dist_lengths[ds]);
+                out.put_bits(token.dist - s_dist_base[ds], s_dist_extra[ds]);
+            } else {
+                out.put_bits(litlen_codes[token.value], lengths[token.value]);
+            }
+        }
+        out.put_bits(litlen_codes[256], lengths[256]);
+    }
+
+}
+
+size_t toybox::deflate(stream_c& stream, const uint8_t* data, size_t len, int window_bits) {
+    assert(window_bits >= 8 && window_bits <= 15 && "Invalid window size");
+    const int32_t window_size = static_cast<int32_t>(1) << window_bits;
+    detail::lz_matcher_c matcher(data, len, window_bits, window_size, min_match, max_match, max_chain);
+    token_s* tokens = static_cast<token_s*>(_malloc(sizeof(token_s) * block_tokens));
+    if (!matcher.good() || !tokens) {
+        _free(tokens);
+        return 0;
+    }
+
+    bit_writer_c out(stream);
+    const uint8_t cmf = static_cast<uint8_t>(((window_bits - 8) << 4) | 8);
+    out.put_byte(cmf);
+    out.put_byte(static_cast<uint8_t>(31 - ((cmf << 8) % 31)));
+
+    const int32_t end = static_cast<int32_t>(len);
+    int count = 0;
+    int32_t pos = 0;
+    while (pos < end) {
+        int32_t dist = 0;
+        int32_t length = matcher.find(pos, dist);
+        if (length && length < max_match && pos + 1 < end) {
+            // Lazy matching, prefer a literal if the next position matches longer.
+            int32_t next_dist = 0;
+            if (matcher.find(pos + 1, next_dist) > length) {
+                length = 0;
+            }
+        }
+        if (length) {
+            tokens[count++] = { static_cast<uint16_t>(length), static_cast<uint16_t>(dist) };
+            pos += length;
+        } else {
+            tokens[count++] = { data[pos], 0 };
+            pos++;
+        }
+        if (count == block_tokens) {
+            write_block(out, tokens, count, pos == end);
+            count = 0;
+        }
+    }
+    if (count || len == 0) {
+        write_block(out, tokens, count, true);
+    }
+    out.align();
+    const uint32_t adler = adler32(1, data, len);
+    for (int shift = 24; shift >= 0; shift -= 8) {
+        out.put_byte(static_cast<uint8_t>(adler >> shift));
+    }
+
+    _free(tokens);
+    return out.finish();
+}
+
+#endif
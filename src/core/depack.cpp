@@ -0,0 +1,371 @@
+//
+//  depack.cpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "core/depack.hpp"
+#include "core/iffstream.hpp"
+
+using namespace toybox;
+
+namespace cc4 {
+    static constexpr cc4_t TBLZ("TBLZ");
+}
+
+namespace {
+    struct depack_header_s {
+        cc4_t id;
+        uint32_t size;
+        uint8_t window_bits;
+        uint8_t _pad[3];
+    };
+    static_assert(sizeof(depack_header_s) == depack_stream_c::header_size, "Header size mismatch");
+
+    constexpr int min_match = 4;
+    constexpr uint8_t max_window_bits = 16;
+}
+
+namespace toybox {
+    template<>
+    struct struct_layout<depack_header_s> {
+        static constexpr const char* value = "4bl4b";
+    };
+}
+
+depack_stream_c::depack_stream_c(stream_c& stream) :
+    codec_stream_c(stream), _origin(stream.tell()), _window_bits(0), _window(nullptr)
+{
+    restart();
+}
+
+depack_stream_c::depack_stream_c(const shared_ptr_c<stream_c>& stream) :
+    codec_stream_c(*stream), _owned(stream), _origin(stream->tell()), _window_bits(0), _window(nullptr)
+{
+    restart();
+}
+
+bool depack_stream_c::restart() {
+    reset_input();
+    _state = state_e::error;
+    _match_nibble = 0;
+    _window_pos = 0;
+    _match_dist = 0;
+    _left = 0;
+    _size = 0;
+    _pos = 0;
+    depack_header_s header;
+    if (_stream.read(&header) != sizeof(header)) {
+        return false;
+    }
+    hton(header);
+    if (header.id != ::cc4::TBLZ || header.window_bits > max_window_bits) {
+        return false;
+    }
+    _window_bits = header.window_bits;
+    _size = header.size;
+    _state = _size ? state_e::token : state_e::done;
+    return true;
+}
+
+depack_stream_c::~depack_stream_c() {
+    if (_window) {
+        _free(_window);
+    }
+}
+
+bool depack_stream_c::is_packed(const uint8_t* data, size_t len) {
+    if (len < header_size) {
+        return false;
+    }
+    return memcmp(data, &::cc4::TBLZ, sizeof(cc4_t)) == 0;
+}
+
+bool depack_stream_c::good() const { return _state != state_e::error; }
+
+ptrdiff_t depack_stream_c::tell() const {
+    return _state == state_e::error ? -1 : _pos;
+}
+
+ptrdiff_t depack_stream_c::seek(ptrdiff_t pos, seekdir_e way) {
+    switch (way) {
+        case seekdir_e::beg:
+            break;
+        case seekdir_e::cur:
+            pos += _pos;
+            break;
+        case seekdir_e::end:
+            pos += _size;
+            break;
+    }
+    if (pos < 0) {
+        return -1;
+    }
+    if (static_cast<size_t>(pos) < _pos || _state == state_e::error) {
+        // Decoding only goes forward, start over.
+        if (_origin < 0 || _stream.seek(_origin, seekdir_e::beg) < 0 || !restart()) {
+            _state = state_e::error;
+            return -1;
+        }
+    }
+    if (!skip(static_cast<size_t>(pos) - _pos)) {
+        return -1;
+    }
+    return tell();
+}
+
+bool depack_stream_c::get_bytes(uint8_t* buf, size_t count) {
+    while (count) {
+        size_t available = _in_end - _in_ptr;
+        if (available == 0) {
+            if (count >= sizeof(_in)) {
+                // Large literal runs bypass the buffer.
+                return _stream.read(buf, count) == count;
+            }
+            if (!refill()) {
+                return false;
+            }
+            available = _in_end - _in_ptr;
+        }
+        const size_t n = MIN(available, count);
+        memcpy(buf, _in_ptr, n);
+        _in_ptr += n;
+        buf += n;
+        count -= n;
+    }
+    return true;
+}
+
+bool depack_stream_c::get_length(size_t& length) {
+    // Lengths of 15 continue with bytes added until one is less than 255.
+    uint8_t byte;
+    do {
+        if (!get_byte(byte)) {
+            return false;
+        }
+        length += byte;
+    } while (byte == 255);
+    return true;
+}
+
+size_t depack_stream_c::read(uint8_t* buf, size_t count) {
+    if (_state == state_e::error || _state == state_e::done) {
+        return 0;
+    }
+    if (_pos == 0 && count >= _size && _window == nullptr) {
+        return read_direct(buf);
+    }
+    return read_window(buf, count);
+}
+
+size_t depack_stream_c::read_direct(uint8_t* buf) {
+    // The destination holds all output so far, no window needed.
+    uint8_t* out = buf;
+    uint8_t* const end = buf + _size;
+    _state = state_e::error;
+    while (out < end) {
+        uint8_t token;
+        if (!get_byte(token)) {
+            return 0;
+        }
+        size_t length = token >> 4;
+        if (length == 15 && !get_length(length)) {
+            return 0;
+        }
+        if (length > static_cast<size_t>(end - out) || !get_bytes(out, length)) {
+            return 0;
+        }
+        out += length;
+        if (out == end) {
+            break; // Last sequence has no match
+        }
+        uint8_t hi, lo;
+        if (!get_byte(hi) || !get_byte(lo)) {
+            return 0;
+        }
+        const uint16_t dist = static_cast<uint16_t>((hi << 8) | lo);
+        length = (token & 15) + min_match;
+        if ((token & 15) == 15 && !get_length(length)) {
+            return 0;
+        }
+        if (dist == 0 || dist > out - buf || length > static_cast<size_t>(end - out)) {
+            return 0;
+        }
+        const uint8_t* from = out - dist;
+        if (dist >= length) {
+            memcpy(out, from, length);
+            out += length;
+        } else {
+            // Overlapping match repeats the last dist bytes.
+            while (length--) {
+                *out++ = *from++;
+            }
+        }
+    }
+    _state = state_e::done;
+    _pos = _size;
+    return _size;
+}
+
+size_t depack_stream_c::read_window(uint8_t* buf, size_t count) {
+    const uint16_t window_mask = static_cast<uint16_t>((static_cast<uint32_t>(1) << _window_bits) - 1);
+    if (_window == nullptr) {
+        _window = static_cast<uint8_t*>(_malloc(static_cast<uint32_t>(window_mask) + 1));
+        if (_window == nullptr) {
+            _state = state_e::error;
+            return 0;
+        }
+    }
+    count = MIN(count, _size - _pos);
+    size_t done = 0;
+    while (done < count && _state != state_e::error) {
+        switch (_state) {
+            case state_e::token: {
+                uint8_t token;
+                _left = 0;
+                if (!get_byte(token)) {
+                    _state = state_e::error;
+                    break;
+                }
+                _left = token >> 4;
+                _match_nibble = token & 15;
+                if (_left == 15 && !get_length(_left)) {
+                    _state = state_e::error;
+                    break;
+                }
+                _state = state_e::literals;
+                break;
+            }
+            case state_e::literals: {
+                const size_t n = MIN(_left, count - done);
+                if (!get_bytes(buf + done, n)) {
+                    _state = state_e::error;
+                    break;
+                }
+                // Keep the window as history for later matches.
+                for (size_t i = 0; i < n; ++i) {
+                    _window[_window_pos] = buf[done + i];
+                    _window_pos = (_window_pos + 1) & window_mask;
+                }
+                done += n;
+                _left -= n;
+                if (_left == 0) {
+                    _state = _pos + done == _size ? state_e::done : state_e::offset;
+                }
+                break;
+            }
+            case state_e::offset: {
+                uint8_t hi, lo;
+                _left = _match_nibble + min_match;
+                if (!get_byte(hi) || !get_byte(lo) || (_match_nibble == 15 && !get_length(_left))) {
+                    _state = state_e::error;
+                    break;
+                }
+                _match_dist = static_cast<uint16_t>((hi << 8) | lo);
+                if (_match_dist == 0 || _match_dist - 1 > window_mask || _match_dist > _pos + done || _left > _size - _pos - done) {
+                    _state = state_e::error;
+                    break;
+                }
+                _state = state_e::match;
+                break;
+            }
+            case state_e::match: {
+                size_t n = MIN(_left, count - done);
+                _left -= n;
+                uint16_t from = (_window_pos - _match_dist) & window_mask;
+                while (n--) {
+                    const uint8_t byte = _window[from];
+                    from = (from + 1) & window_mask;
+                    _window[_window_pos] = byte;
+                    _window_pos = (_window_pos + 1) & window_mask;
+                    buf[done++] = byte;
+                }
+                if (_left == 0) {
+                    _state = _pos + done == _size ? state_e::done : state_e::token;
+                }
+                break;
+            }
+            default:
+                break;
+        }
+        if (_state == state_e::done) {
+            break;
+        }
+    }
+    _pos += done;
+    return done;
+}
+
+#ifndef __M68000__
+
+namespace {
+
+    constexpr int max_chain = 64;
+
+    class lz_writer_c : public detail::byte_writer_c {
+    public:
+        lz_writer_c(stream_c& stream) : byte_writer_c(stream) {}
+
+        void put_length(size_t length) {
+            while (length >= 255) {
+                put_byte(255);
+                length -= 255;
+            }
+            put_byte(static_cast<uint8_t>(length));
+        }
+        void put_sequence(const uint8_t* literals, size_t literal_count, uint16_t dist, size_t match_length) {
+            const size_t match_code = dist ? match_length - min_match : 0;
+            put_byte(static_cast<uint8_t>((MIN(literal_count, static_cast<size_t>(15)) << 4) | MIN(match_code, static_cast<size_t>(15))));
+            if (literal_count >= 15) {
+                put_length(literal_count - 15);
+            }
+            put_bytes(literals, literal_count);
+            if (dist) {
+                put_byte(static_cast<uint8_t>(dist >> 8));
+                put_byte(static_cast<uint8_t>(dist));
+                if (match_code >= 15) {
+                    put_length(match_code - 15);
+                }
+            }
+        }
+    };
+
+}
+
+size_t toybox::lz_compress(stream_c& stream, const uint8_t* data, size_t len, int window_bits) {
+    assert(window_bits >= 8 && window_bits <= max_window_bits && "Invalid window size");
+    // Offsets are 16 bit, so a 64 KB window reaches one byte less.
+    const int32_t max_dist = MIN((static_cast<int32_t>(1) << window_bits), static_cast<int32_t>(0xffff));
+    detail::lz_matcher_c matcher(data, len, window_bits, max_dist, min_match, static_cast<int32_t>(len), max_chain);
+    if (!matcher.good()) {
+        return 0;
+    }
+
+    lz_writer_c out(stream);
+    depack_header_s header = { ::cc4::TBLZ, static_cast<uint32_t>(len), static_cast<uint8_t>(window_bits), { 0 } };
+    hton(header);
+    out.put_bytes(reinterpret_cast<const uint8_t*>(&header), sizeof(header));
+
+    const int32_t end = static_cast<int32_t>(len);
+    int32_t literal_start = 0;
+    int32_t pos = 0;
+    while (pos < end) {
+        int32_t best_dist = 0;
+        const int32_t best = matcher.find(pos, best_dist);
+        if (best) {
+            out.put_sequence(data + literal_start, pos - literal_start, static_cast<uint16_t>(best_dist), best);
+            pos += best;
+            literal_start = pos;
+        } else {
+            pos++;
+        }
+    }
+    if (literal_start < end || end == 0) {
+        out.put_sequence(data + literal_start, end - literal_start, 0, 0);
+    }
+
+    return out.finish();
+}
+
+#endif
@@ -7,6 +7,8 @@
 
 #include "core/iffstream.hpp"
 #include "core/util_stream.hpp"
+#include "core/pack.hpp"
+#include "core/depack.hpp"
 #include "core/expected.hpp"
 
 using namespace toybox;
@@ -26,6 +28,18 @@ const char* cc4_t::cstring() const {
     return buf;
 }
 
+// Buffers reads from file, and unpacks it as it is read if packed.
+static shared_ptr_c<stream_c> buffered_input(shared_ptr_c<stream_c> file) {
+    uint8_t header[depack_stream_c::header_size];
+    const ptrdiff_t start = file->tell();
+    const bool packed = file->read(header, sizeof(header)) == sizeof(header) && depack_stream_c::is_packed(header, sizeof(header));
+    file->seek(start, stream_c::seekdir_e::beg);
+    if (packed) {
+        file = shared_ptr_c<stream_c>(new depack_stream_c(file));
+    }
+    return shared_ptr_c<stream_c>(new bufstream_c(move(file)));
+}
+
 iffstream_c::iffstream_c(shared_ptr_c<stream_c> stream) :
     stream_c(), _stream(move(stream))
 {
@@ -33,9 +47,36 @@ iffstream_c::iffstream_c(shared_ptr_c<stream_c> stream) :
 }
 
 iffstream_c::iffstream_c(const char* path, fstream_c::openmode_e mode) {
+    if (mode == fstream_c::openmode_e::input) {
+        // One bulk read, and chunks can be decoded straight from memory.
+        auto mstream = new expected_c<memstream_c>(failable, path);
+        if (*mstream) {
+            construct_at(this, shared_ptr_c<stream_c>(expected_cast(mstream)));
+            return;
+        }
+        errno = mstream->error();
+        delete mstream;
+        if (errno != ENOMEM) {
+            return;
+        }
+        // Too large to fit in memory, fall back to buffered reads.
+        if (const auto* pack = pack_c::mounted()) {
+            auto file = pack->open(path);
+            if (file) {
+                construct_at(this, buffered_input(move(file)));
+                return;
+            }
+        }
+    }
     auto fstream = new expected_c<fstream_c>(failable, path, mode);
     if (*fstream) {
-        construct_at(this, shared_ptr_c<stream_c>(expected_cast(fstream)));
+        // IFF parsing does many small reads, buffer them into few file reads.
+        shared_ptr_c<stream_c> file(expected_cast(fstream));
+        if (mode == fstream_c::openmode_e::input) {
+            construct_at(this, buffered_input(move(file)));
+        } else {
+            construct_at(this, shared_ptr_c<stream_c>(new bufstream_c(move(file))));
+        }
     } else {
         errno = fstream->error();
         delete fstream;
@@ -172,3 +213,83 @@ bool iffstream_c::read(iff_chunk_s& chunk_out) {
 size_t iffstream_c::read(uint8_t* buf, size_t count) { return _stream->read(buf, count); }
 
 size_t iffstream_c::write(const uint8_t* buf, size_t count) { return _stream->write(buf, count); };
+
+const uint8_t* iffstream_c::view(size_t count) { return _stream->view(count); }
+
+iff_index_c::iff_index_c(iffstream_c& file) {
+    const ptrdiff_t pos = file.tell();
+    iff_chunk_s chunk;
+    if (file.first(cc4::ANY, chunk)) {
+        if (!scan(file, chunk, -1)) {
+            _entries.clear();
+        }
+    }
+    file.seek(pos, stream_c::seekdir_e::beg);
+}
+
+bool iff_index_c::scan(iffstream_c& file, const iff_chunk_s& chunk, int parent) {
+    const int index = _entries.size();
+    assert(index < 0x7fff && "Too many chunks to index");
+    // Entries may be reallocated while scanning children, always access by index.
+    auto& entry = _entries.emplace_back();
+    static_cast<iff_chunk_s&>(entry) = chunk;
+    entry.subtype = cc4::NULL_;
+    entry.parent = parent;
+    entry.end = index + 1;
+    if (is_group(chunk.id)) {
+        iff_group_s group;
+        if (!file.expand(chunk, group)) {
+            return false;
+        }
+        _entries[index].subtype = group.subtype;
+        iff_chunk_s child;
+        while (file.next(group, cc4::ANY, child)) {
+            if (!scan(file, child, index)) {
+                return false;
+            }
+        }
+        _entries[index].end = _entries.size();
+    }
+    // Pad byte of an odd sized last chunk may be missing, the next read fails anyway.
+    file.skip(chunk);
+    return true;
+}
+
+const iff_index_c::entry_s* iff_index_c::find_sibling(int index, int end, cc4_t id) const {
+    while (index < end) {
+        const auto& entry = _entries[index];
+        if (entry.id.matches(id)) {
+            return &entry;
+        }
+        index = entry.end;
+    }
+    return nullptr;
+}
+
+const iff_index_c::entry_s* iff_index_c::first(cc4_t id, cc4_t subtype) const {
+    if (good() && _entries[0].id.matches(id) && _entries[0].subtype.matches(subtype)) {
+        return &_entries[0];
+    }
+    return nullptr;
+}
+
+const iff_index_c::entry_s* iff_index_c::first(const entry_s& group, cc4_t id) const {
+    const int index = static_cast<int>(&group - begin());
+    assert(index >= 0 && index < size() && "Group must be in index");
+    return find_sibling(index + 1, group.end, id);
+}
+
+const iff_index_c::entry_s* iff_index_c::next(const entry_s& chunk, cc4_t id) const {
+    assert(&chunk >= begin() && &chunk < end() && "Chunk must be in index");
+    const int end = chunk.parent < 0 ? size() : _entries[chunk.parent].end;
+    return find_sibling(chunk.end, end, id);
+}
+
+const iff_index_c::entry_s* iff_index_c::find(cc4_t id) const {
+    for (const auto& entry : _entries) {
+        if (entry.id.matches(id)) {
+            return &entry;
+        }
+    }
+    return nullptr;
+}
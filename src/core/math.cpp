@@ -8,36 +8,10 @@
 #include "core/math.hpp"
 #include "core/utility.hpp"
 #include "core/array.hpp"
+#include "core/bitset.hpp"
 
 namespace toybox {
 
-    fix16_t sqrt(fix16_t x) {
-        if (x.raw <= 0) return fix16_t(0);
-        // Initial guess - use magnitude-based heuristics
-        int16_t guess_raw;
-        if (x.raw >= (64 << 4)) {          // x >= 64
-            guess_raw = x.raw >> 3;         // ≈ x/8 (works well for large x)
-        } else if (x.raw >= (16 << 4)) {   // x >= 16
-            guess_raw = x.raw >> 2;         // ≈ x/4
-        } else if (x.raw >= (4 << 4)) {    // x >= 4
-            guess_raw = x.raw >> 1;         // ≈ x/2
-        } else if (x.raw >= (1 << 4)) {    // x >= 1
-            guess_raw = x.raw;              // ≈ x
-        } else {                            // x < 1
-            guess_raw = (1 << 4);           // Guess 1.0
-        }
-        fix16_t guess(guess_raw, true);
-        // Newton-Raphson: x_{n+1} = (x_n + a/x_n) / 2
-        // Iterate up to 6 times with early termination on convergence
-        for (int i = 0; i < 6; ++i) {
-            fix16_t sum = guess + x.div(guess);
-            fix16_t next = sum.div(2);  // Divide by 2
-            if (next.raw == guess.raw) break;  // Converged
-            guess = next;
-        }
-        return guess;
-    }
-
     namespace detail {
         static constexpr float pi2 = 3.14159265358979323846f * 2.0f;
         static constexpr float pi = 3.14159265358979323846f;
@@ -85,6 +59,112 @@ namespace toybox {
             return table;
         }
         
+        static constexpr double sqrt(double x) {
+            if (x <= 0) return 0;
+            double guess = x < 1 ? 1 : x;
+            for (int i = 0; i < 64; ++i) {
+                guess = (guess + x / guess) / 2;
+            }
+            return guess;
+        }
+
+        static constexpr double atan(double t) {
+            // Halve the angle once, atan(t) = 2 * atan(t / (1 + sqrt(1 + t²))), to converge fast for t <= 1
+            t = t / (1 + sqrt(1 + t * t));
+            const double t2 = t * t;
+            double term = t;
+            double result = 0;
+            for (int i = 0; i < 32; ++i) {
+                result += term / (2 * i + 1);
+                term *= -t2;
+            }
+            return result * 2;
+        }
+
+        static constexpr double log2(double m) {
+            // log(m) = 2 * atanh((m - 1) / (m + 1)), converges fast for m in [1, 2]
+            const double z = (m - 1) / (m + 1);
+            const double z2 = z * z;
+            double term = z;
+            double result = 0;
+            for (int i = 0; i < 32; ++i) {
+                result += term / (2 * i + 1);
+                term *= z2;
+            }
+            return result * 2 / 0.693147180559945309417;
+        }
+
+        static constexpr double exp2(double f) {
+            // Taylor series of exp(f * log(2))
+            const double x = f * 0.693147180559945309417;
+            double term = 1;
+            double result = 1;
+            for (int i = 1; i < 32; ++i) {
+                term *= x / i;
+                result += term;
+            }
+            return result;
+        }
+
+        // Table of Count intervals for linear interpolation, with the end point included.
+        template<int Count>
+        struct lut_s {
+            uint16_t values[Count + 1];
+        };
+
+        template<int Count, typename F>
+        static consteval lut_s<Count> build_lut(F func) {
+            lut_s<Count> table{};
+            for (int i = 0; i <= Count; ++i) {
+                table.values[i] = static_cast<uint16_t>(func(i) + 0.5);
+            }
+            return table;
+        }
+
+        // Interpolate between entries, the top bits of x is the index and the low Bits the fraction.
+        template<int Bits, int Count>
+        static __forceinline int32_t lerp(const lut_s<Count>& table, uint16_t x) {
+            const uint16_t i = x >> Bits;
+            const int16_t frac = x & ((1 << Bits) - 1);
+            const int16_t delta = static_cast<int16_t>(table.values[i + 1] - table.values[i]);
+            return table.values[i] + (mul_fast(delta, frac) >> Bits);
+        }
+
+        // 4 * sqrt(m) << 5, for m in [2^13, 2^15) in steps of 2^8
+        static constexpr auto sqrt_table = build_lut<96>([](int i) {
+            return 4 * sqrt(8192 + 256 * i) * 32;
+        });
+        // 64 / sqrt(m) << 15, for m in [2^13, 2^15) in steps of 2^8
+        static constexpr auto rsqrt_table = build_lut<96>([](int i) {
+            return 64 / sqrt(8192 + 256 * i) * 32768;
+        });
+        // 2^29 / m, for m in [2^14, 2^15) in steps of 2^8
+        static constexpr auto recip_table = build_lut<64>([](int i) {
+            return 536870912.0 / (16384 + 256 * i);
+        });
+        // atan(t) << 12, for t in [0, 1) in steps of 1/64
+        static constexpr auto atan_table = build_lut<64>([](int i) {
+            return atan(i / 64.0) * 4096;
+        });
+        // log2(1 + f) << 14, for f in [0, 1) in steps of 1/64
+        static constexpr auto log2_table = build_lut<64>([](int i) {
+            return log2(1 + i / 64.0) * 16384;
+        });
+        // 2^f << 14, for every fraction f of a fix16_t, no interpolation needed
+        static constexpr auto exp2_table = build_lut<15>([](int i) {
+            return exp2(i / 16.0) * 16384;
+        });
+
+        // Shift that normalizes the positive value to [2^14, 2^15).
+        static __forceinline int normalize_shift(uint16_t value) {
+            return countl_zero(value) - 17;
+        }
+
+        template<integral Int>
+        static __forceinline int16_t round_shift(Int value, int shift) {
+            return static_cast<int16_t>((value + (static_cast<Int>(1) << (shift - 1))) >> shift);
+        }
+
         template<integral Int, int Bits>
         static __forceinline constexpr base_fix_t<Int, Bits> exp(base_fix_t<Int, Bits> x) {
             using fix_t = base_fix_t<Int, Bits>;
@@ -178,6 +258,83 @@ namespace toybox {
         }
     }
 
+    fix16_t sqrt(fix16_t x) {
+        if (x.raw <= 0) return fix16_t(0);
+        // sqrt(raw) = sqrt(m) / 2^(shift / 2), for an even shift
+        const int shift = detail::normalize_shift(x.raw) & ~1;
+        const uint16_t m = x.raw << shift;
+        const int32_t r = detail::lerp<8>(detail::sqrt_table, m - 8192);
+        return fix16_t(detail::round_shift(r, 5 + (shift >> 1)), true);
+    }
+
+    fix16_t rsqrt(fix16_t x) {
+        if (x.raw <= 0) return fix16_t(INT16_MAX, true);
+        const int shift = detail::normalize_shift(x.raw) & ~1;
+        const uint16_t m = x.raw << shift;
+        const int32_t r = detail::lerp<8>(detail::rsqrt_table, m - 8192);
+        return fix16_t(detail::round_shift(r, 15 - (shift >> 1)), true);
+    }
+
+    fix16_t reciprocal(fix16_t x) {
+        const bool negative = x.raw < 0;
+        const uint16_t a = negative ? static_cast<uint16_t>(-static_cast<int32_t>(x.raw)) : x.raw;
+        if (a == 0) return fix16_t(INT16_MAX, true);
+        // 1 / x rounds to zero for x > 32.
+        if (a > 512) return fix16_t(0);
+        const int shift = detail::normalize_shift(a);
+        const uint16_t m = a << shift;
+        const int32_t r = detail::lerp<8>(detail::recip_table, m - 16384);
+        const int16_t raw = detail::round_shift(r, 21 - shift);
+        return fix16_t(negative ? -raw : raw, true);
+    }
+
+    fix16_t atan2(fix16_t y, fix16_t x) {
+        uint16_t ax = x.raw < 0 ? static_cast<uint16_t>(-static_cast<int32_t>(x.raw)) : x.raw;
+        uint16_t ay = y.raw < 0 ? static_cast<uint16_t>(-static_cast<int32_t>(y.raw)) : y.raw;
+        if (ax == 0 && ay == 0) return fix16_t(0);
+        // Reduce to the first octant, t = num / den in [0, 1]
+        const bool swapped = ay > ax;
+        uint16_t num = swapped ? ax : ay;
+        uint16_t den = swapped ? ay : ax;
+        if (den & 0x8000) {
+            num >>= 1;
+            den >>= 1;
+        } else {
+            const int shift = detail::normalize_shift(den);
+            num <<= shift;
+            den <<= shift;
+        }
+        // Divide by multiplying with the reciprocal, t is in 1.15
+        const uint16_t recip = detail::lerp<8>(detail::recip_table, den - 16384);
+        const uint32_t t = mul_fast(num, recip) >> 14;
+        int32_t a = detail::lerp<9>(detail::atan_table, t > 32767 ? 32767 : t);
+        // Restore octant and quadrant, in radians << 12
+        constexpr int32_t pi_12 = 12868;
+        if (swapped) a = pi_12 / 2 - a;
+        if (x.raw < 0) a = pi_12 - a;
+        if (y.raw < 0) a = -a;
+        return fix16_t(detail::round_shift(a, 8), true);
+    }
+
+    fix16_t exp2(fix16_t x) {
+        const int16_t n = x.raw >> 4;
+        if (n >= 11) return fix16_t(INT16_MAX, true);
+        // 2^x = 2^n * 2^f, result is 2^f << (n + 4) with the table in << 14
+        const int shift = 10 - n;
+        if (shift > 15) return fix16_t(0);
+        const int32_t r = detail::exp2_table.values[x.raw & 15];
+        return fix16_t(shift == 0 ? static_cast<int16_t>(r) : detail::round_shift(r, shift), true);
+    }
+
+    fix16_t log2(fix16_t x) {
+        if (x.raw <= 0) return fix16_t(INT16_MIN, true);
+        // log2(x) = log2(raw) - 4 = (14 - shift) + log2(m / 2^14) - 4
+        const int shift = detail::normalize_shift(x.raw);
+        const uint16_t m = x.raw << shift;
+        const int32_t r = (static_cast<int32_t>(10 - shift) << 14) + detail::lerp<8>(detail::log2_table, m - 16384);
+        return fix16_t(detail::round_shift(r, 10), true);
+    }
+
     fix16_t exp(fix16_t x) {
         return detail::exp(x);
     }
@@ -207,11 +364,11 @@ namespace toybox {
             return negative_exp ? (numbers::one.div(result)) : result;
         } else {
             // General case: pow(a, b) = exp(b * log(a))
-            // Use fix32_t for intermediate calculation to preserve precision
-            using fix32_t = base_fix_t<int32_t, 20>;
-            const fix32_t base_32 = fix32_t(static_cast<int32_t>(base.raw) << 16, true);
-            const fix32_t exp_32 = fix32_t(static_cast<int32_t>(exp.raw) << 16, true);
-            const fix32_t result = detail::exp(exp_32 * detail::log(base_32));
+            // Use 12:20 for intermediate calculation to preserve precision
+            using fix20_t = base_fix_t<int32_t, 20>;
+            const fix20_t base_32 = fix20_t(static_cast<int32_t>(base.raw) << 16, true);
+            const fix20_t exp_32 = fix20_t(static_cast<int32_t>(exp.raw) << 16, true);
+            const fix20_t result = detail::exp(exp_32 * detail::log(base_32));
             // Add 1 << 15 to round to nearest instead of truncating
             return fix16_t(static_cast<int16_t>((result.raw + (static_cast<int32_t>(1) << 15)) >> 16), true);
         }
@@ -0,0 +1,200 @@
+//
+//  memory_telemetry.cpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "core/memory_telemetry.hpp"
+
+#if TOYBOX_MEMORY_TELEMETRY
+
+using namespace toybox;
+
+// Telemetry must never allocate with operator new, all storage is static or from _calloc.
+namespace {
+    struct entry_s {
+        const void* ptr;
+        uint32_t size;
+        uint8_t label;
+    };
+}
+
+static entry_s* s_entries = nullptr;
+static size_t s_capacity = 0;   // Always power of two, or 0
+static size_t s_live_count = 0;
+static size_t s_live_bytes = 0;
+static size_t s_peak_bytes = 0;
+static size_t s_total_count = 0;
+static size_t s_frame_count = 0;
+static size_t s_peak_frame_count = 0;
+
+static constexpr size_t s_histogram_limits[memory_telemetry_c::histogram_count] = {
+    8, 16, 24, 32, 64, 128, 256, 512, 1024, 4096, 16384, SIZE_MAX
+};
+static size_t s_histogram[memory_telemetry_c::histogram_count] = { 0 };
+
+static const char* s_labels[memory_telemetry_c::max_label_count] = { "unlabeled" };
+static size_t s_label_live_bytes[memory_telemetry_c::max_label_count] = { 0 };
+static size_t s_label_peak_bytes[memory_telemetry_c::max_label_count] = { 0 };
+static int s_label_count = 1;
+static uint8_t s_label_stack[16] = { 0 };
+static int s_label_depth = 0;
+
+static __forceinline size_t hash_ptr(const void* ptr) {
+    auto v = reinterpret_cast<uintptr_t>(ptr);
+    v ^= v >> 17;
+    v *= 0x9E3779B1u;
+    return v ^ (v >> 15);
+}
+
+static void insert_entry(entry_s* entries, size_t capacity, const entry_s& entry) {
+    size_t i = hash_ptr(entry.ptr) & (capacity - 1);
+    while (entries[i].ptr) {
+        i = (i + 1) & (capacity - 1);
+    }
+    entries[i] = entry;
+}
+
+static void grow_entries() {
+    const size_t capacity = s_capacity ? s_capacity * 2 : 1024;
+    auto entries = static_cast<entry_s*>(_calloc(capacity, sizeof(entry_s)));
+    hard_assert(entries && "Memory telemetry out of memory");
+    for (size_t i = 0; i < s_capacity; ++i) {
+        if (s_entries[i].ptr) {
+            insert_entry(entries, capacity, s_entries[i]);
+        }
+    }
+    _free(s_entries);
+    s_entries = entries;
+    s_capacity = capacity;
+}
+
+void memory_telemetry_c::did_allocate(const void* ptr, size_t size) {
+    if (!ptr) {
+        return;
+    }
+    if ((s_live_count + 1) * 2 > s_capacity) {
+        grow_entries();
+    }
+    const uint8_t label = s_label_depth ? s_label_stack[s_label_depth - 1] : 0;
+    insert_entry(s_entries, s_capacity, (entry_s){ ptr, (uint32_t)size, label });
+    s_live_count++;
+    s_total_count++;
+    s_live_bytes += size;
+    s_peak_bytes = MAX(s_peak_bytes, s_live_bytes);
+    s_frame_count++;
+    s_peak_frame_count = MAX(s_peak_frame_count, s_frame_count);
+    s_label_live_bytes[label] += size;
+    s_label_peak_bytes[label] = MAX(s_label_peak_bytes[label], s_label_live_bytes[label]);
+    int bucket = 0;
+    while (size > s_histogram_limits[bucket]) {
+        bucket++;
+    }
+    s_histogram[bucket]++;
+}
+
+void memory_telemetry_c::did_deallocate(const void* ptr) {
+    if (!ptr || !s_capacity) {
+        return;
+    }
+    const size_t mask = s_capacity - 1;
+    size_t i = hash_ptr(ptr) & mask;
+    while (s_entries[i].ptr != ptr) {
+        if (!s_entries[i].ptr) {
+            // Not tracked, memory from _malloc released with delete.
+            return;
+        }
+        i = (i + 1) & mask;
+    }
+    const auto& entry = s_entries[i];
+    s_live_count--;
+    s_live_bytes -= entry.size;
+    s_label_live_bytes[entry.label] -= entry.size;
+    // Backward shift deletion, keeps probe sequences intact without tombstones.
+    size_t j = i;
+    while (true) {
+        j = (j + 1) & mask;
+        if (!s_entries[j].ptr) {
+            break;
+        }
+        const size_t home = hash_ptr(s_entries[j].ptr) & mask;
+        if (((j - home) & mask) >= ((j - i) & mask)) {
+            s_entries[i] = s_entries[j];
+            i = j;
+        }
+    }
+    s_entries[i].ptr = nullptr;
+}
+
+void memory_telemetry_c::begin_frame() {
+    s_frame_count = 0;
+}
+
+memory_telemetry_c::stats_s memory_telemetry_c::stats() {
+    return { s_live_bytes, s_peak_bytes, s_live_count, s_total_count, s_frame_count, s_peak_frame_count };
+}
+
+size_t memory_telemetry_c::histogram_limit(int bucket) {
+    assert(bucket >= 0 && bucket < histogram_count && "Bucket out of bounds");
+    return s_histogram_limits[bucket];
+}
+
+size_t memory_telemetry_c::histogram(int bucket) {
+    assert(bucket >= 0 && bucket < histogram_count && "Bucket out of bounds");
+    return s_histogram[bucket];
+}
+
+int memory_telemetry_c::label_count() {
+    return s_label_count;
+}
+
+memory_telemetry_c::label_stats_s memory_telemetry_c::label_stats(int index) {
+    assert(index >= 0 && index < s_label_count && "Label index out of bounds");
+    return { s_labels[index], s_label_live_bytes[index], s_label_peak_bytes[index] };
+}
+
+const char* memory_telemetry_c::label() {
+    return s_labels[s_label_depth ? s_label_stack[s_label_depth - 1] : 0];
+}
+
+void memory_telemetry_c::push_label(const char* label) {
+    assert(s_label_depth < (int)sizeof(s_label_stack) && "Label stack overflow");
+    int index = 0;
+    while (index < s_label_count && strcmp(s_labels[index], label) != 0) {
+        index++;
+    }
+    if (index == s_label_count) {
+        if (s_label_count == max_label_count) {
+            // Out of labels, attribute to unlabeled.
+            index = 0;
+        } else {
+            s_labels[s_label_count++] = label;
+        }
+    }
+    s_label_stack[s_label_depth++] = index;
+}
+
+void memory_telemetry_c::pop_label() {
+    assert(s_label_depth > 0 && "Label stack underflow");
+    s_label_depth--;
+}
+
+void memory_telemetry_c::print_report(const char* title) {
+    printf("Memory report: %s\n\r", title);
+    printf("  live: %ld bytes in %ld allocations, peak: %ld bytes\n\r", (long)s_live_bytes, (long)s_live_count, (long)s_peak_bytes);
+    printf("  total: %ld allocations, peak per frame: %ld\n\r", (long)s_total_count, (long)s_peak_frame_count);
+    printf("  sizes:");
+    for (int bucket = 0; bucket < histogram_count; ++bucket) {
+        if (bucket < histogram_count - 1) {
+            printf(" <=%ld:%ld", (long)s_histogram_limits[bucket], (long)s_histogram[bucket]);
+        } else {
+            printf(" >%ld:%ld\n\r", (long)s_histogram_limits[bucket - 1], (long)s_histogram[bucket]);
+        }
+    }
+    for (int index = 0; index < s_label_count; ++index) {
+        printf("  %-24s live: %8ld, peak: %8ld\n\r", s_labels[index], (long)s_label_live_bytes[index], (long)s_label_peak_bytes[index]);
+    }
+}
+
+#endif
@@ -0,0 +1,214 @@
+//
+//  pack.cpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "core/pack.hpp"
+#include "core/util_stream.hpp"
+#include "core/iffstream.hpp"
+#include "core/algorithm.hpp"
+#include "core/depack.hpp"
+#include <errno.h>
+
+using namespace toybox;
+
+namespace cc4 {
+    static constexpr cc4_t TBPK("TBPK");
+}
+
+namespace {
+    struct pack_header_s {
+        cc4_t id;
+        uint16_t version;
+        uint16_t count;
+    };
+    static_assert(sizeof(pack_header_s) == 8, "Header size mismatch");
+    static_assert(sizeof(pack_c::entry_s) == 32, "Entry size mismatch");
+    static constexpr uint16_t pack_version = 1;
+
+    __forceinline char normalized(char c) {
+        return c == '\\' ? '/' : static_cast<char>(tolower(static_cast<uint8_t>(c)));
+    }
+
+    // Compares a stored name with a name in any case and with any separator.
+    int compare_name(const char* stored, const char* name) {
+        while (true) {
+            const char c = normalized(*name++);
+            const int diff = static_cast<uint8_t>(*stored) - static_cast<uint8_t>(c);
+            if (diff || c == 0) {
+                return diff;
+            }
+            stored++;
+        }
+    }
+}
+
+namespace toybox {
+    template<>
+    struct struct_layout<pack_header_s> {
+        static constexpr const char* value = "4b2w";
+    };
+    template<>
+    struct struct_layout<pack_c::entry_s> {
+        static constexpr const char* value = "2l24b";
+    };
+}
+
+static const pack_c* s_mounted = nullptr;
+
+pack_c::pack_c(const char* path) : _path(nullptr) {
+    // fstream_c does not own its path.
+    const size_t len = strlen(path);
+    _path = static_cast<char*>(_malloc(len + 1));
+    memcpy(_path, path, len + 1);
+    auto* file = new fstream_c(_path);
+    if (!file->is_open()) {
+        delete file;
+        if (errno == 0) {
+            errno = ENOENT;
+        }
+        return;
+    }
+    shared_ptr_c<stream_c> stream(file);
+    pack_header_s header;
+    if (stream->read(&header) != sizeof(header)) {
+        errno = EINVAL;
+        return;
+    }
+    hton(header);
+    if (header.id != ::cc4::TBPK || header.version != pack_version) {
+        errno = EINVAL;
+        return; // Not a pack
+    }
+    _entries.resize(header.count);
+    const size_t toc_size = header.count * sizeof(entry_s);
+    if (stream->read(_entries.data(), header.count) != toc_size) {
+        _entries.clear();
+        errno = EINVAL;
+        return;
+    }
+    for (auto& entry : _entries) {
+        hton(entry);
+    }
+    _stream = move(stream);
+}
+
+pack_c::~pack_c() {
+    if (s_mounted == this) {
+        s_mounted = nullptr;
+    }
+    _stream.reset();
+    _free(_path);
+}
+
+const pack_c::entry_s* pack_c::find(const char* name) const {
+    auto it = lower_bound(begin(), end(), name, [](const entry_s& entry, const char* name) {
+        return compare_name(entry.name, name) < 0;
+    });
+    if (it != end() && compare_name(it->name, name) == 0) {
+        return it;
+    }
+    return nullptr;
+}
+
+shared_ptr_c<stream_c> pack_c::open(const char* name) const {
+    const entry_s* entry = good() ? find(name) : nullptr;
+    if (entry == nullptr) {
+        return shared_ptr_c<stream_c>();
+    }
+    shared_ptr_c<stream_c> file(new substream_c(_stream, entry->offset, entry->size));
+    file->seek(0, stream_c::seekdir_e::beg);
+    return file;
+}
+
+void pack_c::mount(const pack_c* pack) {
+    assert((pack == nullptr || pack->good()) && "Pack must be good");
+    s_mounted = pack;
+}
+
+const pack_c* pack_c::mounted() {
+    return s_mounted;
+}
+
+#ifndef __M68000__
+
+bool pack_c::create(const char* path, const char* const* files, int count, bool compress) {
+    struct item_s {
+        entry_s entry;
+        const char* file;
+        bool packed;
+    };
+    vector_c<item_s, 0> items;
+    for (int i = 0; i < count; ++i) {
+        auto& item = items.emplace_back();
+        memset(&item.entry, 0, sizeof(entry_s));
+        item.file = files[i];
+        item.packed = false;
+        const size_t len = strlen(files[i]);
+        if (len > max_name_length) {
+            printf("Name too long '%s'.\n", files[i]);
+            return false;
+        }
+        for (size_t j = 0; j < len; ++j) {
+            item.entry.name[j] = normalized(files[i][j]);
+        }
+    }
+    sort(items.begin(), items.end(), [](const item_s& a, const item_s& b) {
+        return strcmp(a.entry.name, b.entry.name) < 0;
+    });
+    uint32_t offset = sizeof(pack_header_s) + count * sizeof(entry_s);
+    for (int i = 0; i < count; ++i) {
+        if (i > 0 && strcmp(items[i - 1].entry.name, items[i].entry.name) == 0) {
+            printf("Duplicate name '%s'.\n", items[i].file);
+            return false;
+        }
+        memstream_c data(items[i].file);
+        if (!data.good()) {
+            printf("Could not read '%s'.\n", items[i].file);
+            return false;
+        }
+        offset = (offset + alignment - 1) & ~static_cast<uint32_t>(alignment - 1);
+        items[i].entry.offset = offset;
+        items[i].entry.size = static_cast<uint32_t>(data.size());
+        if (compress) {
+            // Only keep files packed that got smaller.
+            strstream_c packed(data.size() + data.size() / 255 + 32);
+            const size_t packed_size = lz_compress(packed, data.data(), data.size());
+            if (packed_size && packed_size < data.size()) {
+                items[i].entry.size = static_cast<uint32_t>(packed_size);
+                items[i].packed = true;
+            }
+        }
+        offset += items[i].entry.size;
+    }
+
+    fstream_c out(path, fstream_c::openmode_e::output);
+    if (!out.is_open()) {
+        return false;
+    }
+    pack_header_s header = { ::cc4::TBPK, pack_version, static_cast<uint16_t>(count) };
+    hton(header);
+    bool ok = out.write(&header) == sizeof(header);
+    for (auto& item : items) {
+        entry_s entry = item.entry;
+        hton(entry);
+        ok = ok && out.write(&entry) == sizeof(entry);
+    }
+    size_t pos = sizeof(pack_header_s) + count * sizeof(entry_s);
+    static const uint8_t s_padding[alignment] = { 0 };
+    for (auto& item : items) {
+        ok = ok && out.write(s_padding, item.entry.offset - pos) == item.entry.offset - pos;
+        memstream_c data(item.file);
+        if (item.packed) {
+            ok = ok && data.good() && lz_compress(out, data.data(), data.size()) == item.entry.size;
+        } else {
+            ok = ok && data.size() == item.entry.size && out.write(data.data(), data.size()) == data.size();
+        }
+        pos = item.entry.offset + item.entry.size;
+    }
+    return ok;
+}
+
+#endif
@@ -0,0 +1,102 @@
+//
+//  slab_allocator.cpp
+//  toybox
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "core/slab_allocator.hpp"
+
+using namespace toybox;
+
+// All statics are constant initialized, operator new may be called before static constructors run.
+static void* s_free_lists[slab_allocator_c::size_class_count] = { nullptr };
+static const void* s_chunks[slab_allocator_c::max_chunk_count] = { nullptr };  // Sorted by address
+static int s_chunk_count = 0;
+
+void* slab_allocator_c::allocate(size_t size) {
+    const int idx = size_class(size);
+    if (idx < 0) {
+        return _malloc(size);
+    }
+    if (!s_free_lists[idx] && !_grow(idx)) {
+        // Out of chunks, let libc handle it.
+        return _malloc(size);
+    }
+    auto block = static_cast<block_t*>(s_free_lists[idx]);
+    s_free_lists[idx] = block->next;
+    return block;
+}
+
+void slab_allocator_c::deallocate(void* ptr) {
+    if (!ptr) {
+        return;
+    }
+    auto chunk = _find_chunk(ptr);
+    if (!chunk) {
+        _free(ptr);
+        return;
+    }
+    const int idx = chunk->size_class;
+    auto block = static_cast<block_t*>(ptr);
+    block->next = static_cast<block_t*>(s_free_lists[idx]);
+    s_free_lists[idx] = block;
+}
+
+bool slab_allocator_c::owns(const void* ptr) {
+    return _find_chunk(ptr) != nullptr;
+}
+
+bool slab_allocator_c::_grow(int size_class) {
+    if (s_chunk_count == max_chunk_count) {
+        return false;
+    }
+    auto chunk = static_cast<chunk_t*>(_malloc(chunk_size));
+    if (!chunk) {
+        return false;
+    }
+    chunk->size_class = size_class;
+    // Thread all blocks of the chunk onto the free list
+    const size_t block_size = size_classes[size_class];
+    const int block_count = (int)((chunk_size - sizeof(chunk_t)) / block_size);
+    auto first = reinterpret_cast<block_t*>(&chunk->data[0]);
+    auto block = first;
+    for (int i = 1; i < block_count; ++i) {
+        auto next = reinterpret_cast<block_t*>(&chunk->data[i * block_size]);
+        block->next = next;
+        block = next;
+    }
+    block->next = static_cast<block_t*>(s_free_lists[size_class]);
+    s_free_lists[size_class] = first;
+    // Insert chunk sorted by address
+    int at = s_chunk_count;
+    while (at > 0 && s_chunks[at - 1] > chunk) {
+        s_chunks[at] = s_chunks[at - 1];
+        at--;
+    }
+    s_chunks[at] = chunk;
+    s_chunk_count++;
+    return true;
+}
+
+slab_allocator_c::chunk_t* slab_allocator_c::_find_chunk(const void* ptr) {
+    // Binary search for last chunk starting at or before ptr
+    int lo = 0;
+    int hi = s_chunk_count;
+    while (lo < hi) {
+        const int mid = (lo + hi) >> 1;
+        if (s_chunks[mid] <= ptr) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo == 0) {
+        return nullptr;
+    }
+    auto chunk = static_cast<const uint8_t*>(s_chunks[lo - 1]);
+    if (static_cast<const uint8_t*>(ptr) >= chunk + chunk_size) {
+        return nullptr;
+    }
+    return const_cast<chunk_t*>(reinterpret_cast<const chunk_t*>(chunk));
+}
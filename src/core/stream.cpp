@@ -7,6 +7,13 @@
 
 #include "core/stream.hpp"
 #include "core/util_stream.hpp"
+#include "core/pack.hpp"
+#include "core/depack.hpp"
+#include <errno.h>
+#ifdef TOYBOX_HOST
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
 
 using namespace toybox;
 
@@ -14,6 +21,7 @@ stream_c::stream_c() : _width(0), _fill(' ') {};
 
 bool stream_c::good() const { return true; };
 bool stream_c::flush() { return true; }
+const uint8_t* stream_c::view(size_t count) { return nullptr; }
 
 stream_c& stream_c::operator<<(manipulator_f m) {
     return m(*this);
@@ -216,3 +224,232 @@ size_t strstream_c::write(const uint8_t* buf, size_t count) {
     _max = MAX(_max, _pos);
     return count;
 }
+
+memstream_c::memstream_c(const uint8_t* buf, size_t len) :
+    stream_c(), _buf(buf), _len(len), _pos(0), _storage(storage_e::borrowed)
+{
+    assert(buf && "Buffer must not be null");
+}
+
+static struct {
+    const char* path;
+    uint8_t* buf;
+    size_t len;
+} s_prefetched = { nullptr, nullptr, 0 };
+
+void memstream_c::prefetch(const char* path, uint8_t* buf, size_t len) {
+    if (s_prefetched.buf) {
+        _free(s_prefetched.buf);
+    }
+    s_prefetched = { path, buf, len };
+}
+
+memstream_c::memstream_c(const char* path) :
+    stream_c(), _buf(nullptr), _len(0), _pos(0), _storage(storage_e::borrowed)
+{
+    if (s_prefetched.buf && strcmp(path, s_prefetched.path) == 0) {
+        _buf = s_prefetched.buf;
+        _len = s_prefetched.len;
+        _storage = storage_e::allocated;
+        s_prefetched = { nullptr, nullptr, 0 };
+        unpack();
+        return;
+    }
+    if (const auto* pack = pack_c::mounted()) {
+        auto file = pack->open(path);
+        if (file) {
+            load(*file);
+            return;
+        }
+    }
+#ifdef TOYBOX_HOST
+    FILE* file = _fopen(path, "rb");
+    if (file == nullptr) {
+        return;
+    }
+    struct stat st;
+    if (fstat(fileno(file), &st) == 0 && st.st_size > 0) {
+        void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fileno(file), 0);
+        if (map != MAP_FAILED) {
+            _buf = static_cast<const uint8_t*>(map);
+            _len = st.st_size;
+            _storage = storage_e::mapped;
+            unpack();
+        }
+    }
+    if (_buf == nullptr) {
+        // Empty and special files can not be mapped, read them instead.
+        fstream_c stream(file);
+        load(stream);
+    }
+    fclose(file);
+#else
+    fstream_c file(path);
+    if (file.good()) {
+        load(file);
+    } else if (errno == 0) {
+        errno = ENOENT;
+    }
+#endif
+}
+
+memstream_c::memstream_c(stream_c& stream) :
+    stream_c(), _buf(nullptr), _len(0), _pos(0), _storage(storage_e::borrowed)
+{
+    load(stream);
+}
+
+memstream_c::~memstream_c() {
+    free_buffer(_buf, _len, _storage);
+}
+
+void memstream_c::free_buffer(const uint8_t* buf, size_t len, storage_e storage) {
+    switch (storage) {
+        case storage_e::allocated:
+            _free(const_cast<uint8_t*>(buf));
+            break;
+        case storage_e::mapped:
+#ifdef TOYBOX_HOST
+            munmap(const_cast<uint8_t*>(buf), len);
+#endif
+            break;
+        default:
+            break;
+    }
+}
+
+uint8_t* memstream_c::release() {
+    uint8_t* buf = nullptr;
+    if (_storage == storage_e::allocated) {
+        buf = const_cast<uint8_t*>(_buf);
+    } else if (_buf) {
+        // Borrowed and mapped buffers are not ours to hand over, copy them.
+        buf = static_cast<uint8_t*>(_malloc(MAX(_len, 1)));
+        if (buf) {
+            memcpy(buf, _buf, _len);
+        } else {
+            errno = ENOMEM;
+        }
+        free_buffer(_buf, _len, _storage);
+    }
+    _buf = nullptr;
+    _len = 0;
+    _pos = 0;
+    _storage = storage_e::borrowed;
+    return buf;
+}
+
+bool memstream_c::unpack() {
+    if (!depack_stream_c::is_packed(_buf, _len)) {
+        return true;
+    }
+    // Decode from the packed buffer, then release it.
+    const uint8_t* buf = _buf;
+    const size_t len = _len;
+    const storage_e storage = _storage;
+    _buf = nullptr;
+    _len = 0;
+    _storage = storage_e::borrowed;
+    memstream_c packed(buf, len);
+    const bool result = load_packed(packed);
+    free_buffer(buf, len, storage);
+    return result;
+}
+
+bool memstream_c::load(stream_c& stream) {
+    // Read from the current position to the end.
+    const ptrdiff_t start = stream.tell();
+    if (start < 0 || stream.seek(0, seekdir_e::end) < 0) {
+        errno = EINVAL;
+        return false;
+    }
+    const ptrdiff_t end = stream.tell();
+    stream.seek(start, seekdir_e::beg);
+    if (end < start) {
+        errno = EINVAL;
+        return false;
+    }
+    const size_t len = end - start;
+    uint8_t* buf = static_cast<uint8_t*>(_malloc(MAX(len, 1)));
+    if (buf == nullptr) {
+        errno = ENOMEM;
+        return false;
+    }
+    if (stream.read(buf, len) != len) {
+        _free(buf);
+        errno = EIO;
+        return false;
+    }
+    _buf = buf;
+    _len = len;
+    _storage = storage_e::allocated;
+    return unpack();
+}
+
+bool memstream_c::load_packed(stream_c& stream) {
+    depack_stream_c depack(stream);
+    if (!depack.good()) {
+        errno = EINVAL;
+        return false;
+    }
+    const size_t len = depack.size();
+    uint8_t* buf = static_cast<uint8_t*>(_malloc(MAX(len, 1)));
+    if (buf == nullptr) {
+        errno = ENOMEM;
+        return false;
+    }
+    if (depack.read(buf, len) != len) {
+        _free(buf);
+        errno = EIO;
+        return false;
+    }
+    _buf = buf;
+    _len = len;
+    _storage = storage_e::allocated;
+    return true;
+}
+
+bool memstream_c::good() const { return _buf != nullptr; }
+
+ptrdiff_t memstream_c::tell() const {
+    return _pos;
+}
+
+ptrdiff_t memstream_c::seek(ptrdiff_t pos, seekdir_e way) {
+    switch (way) {
+        case seekdir_e::cur:
+            pos += _pos;
+            break;
+        case seekdir_e::end:
+            pos += _len;
+            break;
+        default:
+            break;
+    }
+    if (pos < 0 || pos > static_cast<ptrdiff_t>(_len)) {
+        return -1;
+    }
+    _pos = pos;
+    return _pos;
+}
+
+size_t memstream_c::read(uint8_t* buf, size_t count) {
+    count = MIN(count, _len - _pos);
+    memcpy(buf, _buf + _pos, count);
+    _pos += count;
+    return count;
+}
+
+size_t memstream_c::write(const uint8_t* buf, size_t count) {
+    assert(false && "memstream_c is read only");
+    return 0;
+}
+
+const uint8_t* memstream_c::view(size_t count) {
+    if (count > _len - _pos) {
+        return nullptr;
+    }
+    const uint8_t* ptr = _buf + _pos;
+    _pos += count;
+    return ptr;
+}
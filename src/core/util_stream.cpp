@@ -26,7 +26,7 @@ ptrdiff_t substream_c::seek(ptrdiff_t pos, seekdir_e way) {
             _stream->seek(pos, way);
             break;
         case seekdir_e::end:
-            _stream->seek(pos + _origin + _length, way);
+            _stream->seek(_origin + _length + pos, seekdir_e::beg);
             break;
     }
     return tell();
@@ -49,3 +49,137 @@ size_t substream_c::write(const uint8_t* buf, size_t count) {
     }
     return count;
 }
+
+const uint8_t* substream_c::view(size_t count) {
+    assert(tell() >= 0 && "Substream out of range");
+    if (count > static_cast<size_t>(_length - tell())) {
+        return nullptr;
+    }
+    return _stream->view(count);
+}
+
+bufstream_c::bufstream_c(shared_ptr_c<stream_c> stream, size_t size) :
+    _stream(move(stream)), _buf(static_cast<uint8_t*>(_malloc(size))), _size(size),
+    _base(0), _pos(0), _len(0), _dirty(false)
+{
+    assert(_stream && "Stream must not be null");
+    _base = _stream->tell();
+}
+
+bufstream_c::~bufstream_c() {
+    flush_buffer();
+}
+
+bool bufstream_c::good() const { return _stream->good(); }
+
+ptrdiff_t bufstream_c::tell() const {
+    return _base < 0 ? -1 : _base + _pos;
+}
+
+bool bufstream_c::flush_buffer() {
+    bool result = true;
+    if (_dirty) {
+        result = _stream->write(_buf.get(), _len) == _len;
+        _base += _len;
+        _pos = _len = 0;
+        _dirty = false;
+    }
+    return result;
+}
+
+void bufstream_c::drop_read_buffer() {
+    // The wrapped stream is at the end of the buffer, move it to our position.
+    if (_pos != _len) {
+        _stream->seek(_base + _pos, seekdir_e::beg);
+    }
+    _base += _pos;
+    _pos = _len = 0;
+}
+
+ptrdiff_t bufstream_c::seek(ptrdiff_t pos, seekdir_e way) {
+    if (way != seekdir_e::end) {
+        const ptrdiff_t target = way == seekdir_e::beg ? pos : tell() + pos;
+        if (!_dirty && target >= _base && target <= _base + static_cast<ptrdiff_t>(_len)) {
+            _pos = target - _base;
+            return target;
+        }
+        if (!flush_buffer() || target < 0 || _stream->seek(target, seekdir_e::beg) < 0) {
+            return -1;
+        }
+        _base = target;
+    } else {
+        if (!flush_buffer() || _stream->seek(pos, way) < 0) {
+            return -1;
+        }
+        _base = _stream->tell();
+    }
+    _pos = _len = 0;
+    return _base;
+}
+
+bool bufstream_c::flush() {
+    return flush_buffer() && _stream->flush();
+}
+
+size_t bufstream_c::read(uint8_t* buf, size_t count) {
+    if (_dirty && !flush_buffer()) {
+        return 0;
+    }
+    size_t done = 0;
+    while (done < count) {
+        const size_t avail = _len - _pos;
+        if (avail > 0) {
+            const size_t n = MIN(avail, count - done);
+            memcpy(buf + done, _buf.get() + _pos, n);
+            _pos += n;
+            done += n;
+        } else if (count - done >= _size) {
+            // Large reads go directly to the caller's buffer.
+            _base += _len;
+            _pos = _len = 0;
+            const size_t n = _stream->read(buf + done, count - done);
+            _base += n;
+            done += n;
+            break;
+        } else {
+            _base += _len;
+            _pos = 0;
+            _len = _stream->read(_buf.get(), _size);
+            if (_len == 0) {
+                break;
+            }
+        }
+    }
+    return done;
+}
+
+size_t bufstream_c::write(const uint8_t* buf, size_t count) {
+    if (!_dirty) {
+        drop_read_buffer();
+    }
+    if (count >= _size || _len + count > _size) {
+        if (!flush_buffer()) {
+            return 0;
+        }
+        if (count >= _size) {
+            // Large writes go directly to the wrapped stream.
+            const size_t n = _stream->write(buf, count);
+            _base += n;
+            return n;
+        }
+    }
+    memcpy(_buf.get() + _len, buf, count);
+    _len += count;
+    _pos = _len;
+    _dirty = true;
+    return count;
+}
+
+const uint8_t* bufstream_c::view(size_t count) {
+    if (_dirty || count > _len - _pos) {
+        return nullptr;
+    }
+    const uint8_t* ptr = _buf.get() + _pos;
+    _pos += count;
+    return ptr;
+}
@@ -6,7 +6,8 @@
 //
 
 #include "machine/timer.hpp"
-#include "core/list.hpp"
+#include "core/intrusive_list.hpp"
+#include "core/pool_allocator.hpp"
 
 using namespace toybox;
 
@@ -16,17 +17,29 @@ using namespace toybox;
 #include "machine/host_bridge.hpp"
 #endif
 
-struct  timer_func_s {
-uint8_t freq;
-uint8_t cnt;
-timer_c::func_a_t func;
-void* context;
+#define TIMER_FUNC_MAX_CNT 16
+
+// Layout must match timer_func struct in system_helpers_atari.S
+struct  timer_func_s : public intrusive_list_node_s<timer_func_s> {
+    timer_func_s(uint8_t freq, uint8_t cnt, timer_c::func_a_t func, void* context) :
+        freq(freq), cnt(cnt), func(func), context(context) {}
+    uint8_t freq;
+    uint8_t cnt;
+    timer_c::func_a_t func;
+    void* context;
+    void* operator new(size_t count) {
+        assert(allocator::alloc_size >= count && "Allocation size exceeds allocator capacity");
+        return allocator::allocate();
+    }
+    void operator delete(void* ptr) {
+        allocator::deallocate(ptr);
+    }
+    using allocator = pool_allocator_c<timer_func_s, TIMER_FUNC_MAX_CNT>;
 };
 
-#define TIMER_FUNC_MAX_CNT 16
-using timer_func_list_c = list_c<timer_func_s, TIMER_FUNC_MAX_CNT>;
+using timer_func_list_c = intrusive_list_c<timer_func_s>;
 #ifdef __M68000__
-static_assert(sizeof(timer_func_list_c::detail::node_s) == 14, "timer_func_list_c::detail::node_s size mismatch");
+static_assert(sizeof(timer_func_s) == 18, "timer_func_s size mismatch");
 #endif
 
 timer_func_list_c g_vbl_functions;
@@ -95,25 +108,19 @@ void timer_c::add_func(const func_a_t func, void* context, uint8_t freq) {
     }
     with_paused_timers([this, func, context, freq] {
         auto&functions = _timer == timer_e::vbl ? g_vbl_functions : g_clock_functions;
-        functions.push_front((timer_func_s){freq, base_freq(), func, context});
+        functions.push_front(*new timer_func_s(freq, base_freq(), func, context));
     });
 }
 
 void timer_c::remove_func(const func_a_t func, const void* context) {
     with_paused_timers([this, func, context] {
         auto&functions = _timer == timer_e::vbl ? g_vbl_functions : g_clock_functions;
-        auto prev = functions.before_begin();
-        auto curr = functions.begin();
-        auto pred = [&func, &context](const timer_func_s& f) __forceinline_lambda {
-            return f.func == func && f.context == context;
-        };
-        while (curr != functions.end()) {
-            if (pred(*curr)) {
-                functions.erase_after(prev);
+        for (auto& timer_func : functions) {
+            if (timer_func.func == func && timer_func.context == context) {
+                functions.erase(timer_func);
+                delete &timer_func;
                 return;
             }
-            prev = curr;
-            ++curr;
         }
         assert(0 && "Timer function not found in list");
     });
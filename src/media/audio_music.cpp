@@ -43,21 +43,20 @@ music_c::music_c(const char* path) :
         return;
     }
 
-    fstream_c file(path);
+    memstream_c file(path);
     if (!file.good()) {
         if (errno == 0) {
             errno = EINVAL;
         }
         return;
     }
-    file.seek(0, stream_c::seekdir_e::end);
-    const size_t size = file.tell();
-    file.seek(0, stream_c::seekdir_e::beg);
-
-    _data.reset((uint8_t*)_malloc(size));
-    _length = size;
-    const size_t read = file.read(_data.get(), size);
-    assert(read == size && "Failed to read music file");
+    // Take over the loaded buffer, a music file is never held twice.
+    _length = file.size();
+    _data.reset(file.release());
+    if (!_data) {
+        _length = 0;
+        return;
+    }
 
     if (_format == format_e::sndh) {
         assert(memcmp(_data.get() + 12, "SNDH", 4) == 0 && "File must be valid SNDH");
@@ -8,6 +8,7 @@
 #include "media/image.hpp"
 #include "media/canvas.hpp"
 #include "core/iffstream.hpp"
+#include "core/deflate.hpp"
 #include <errno.h>
 
 using namespace toybox;
@@ -121,24 +122,30 @@ namespace toybox {
     };
 }
 
-static void image_read(iffstream_c& file, uint16_t line_words, int height, uint16_t* bitmap, uint16_t* maskmap) {
+static void image_read(stream_c& file, uint16_t line_words, int height, uint16_t* bitmap, uint16_t* maskmap) {
     uint16_t word_buffer[line_words];
     const int bp_count = (maskmap ? 5 : 4);
+    const size_t line_bytes = line_words * 2;
     while_dbra_count(height, height) {
         for (int bp = 0; bp < bp_count; bp++) {
-            uint16_t* buffer;
-            if (bp < 4) {
-                buffer = (uint16_t*)word_buffer;
-            } else {
-                buffer = (uint16_t*)maskmap;
-            }
-            if (!file.read(buffer, line_words)) {
-                return; // Failed to read line
+            // Decode straight out of the stream buffer when possible.
+            const uint16_t* buffer = reinterpret_cast<const uint16_t*>(file.view(line_bytes));
+            if (buffer == nullptr) {
+                if (file.read(reinterpret_cast<uint8_t*>(word_buffer), line_bytes) != line_bytes) {
+                    return; // Failed to read line
+                }
+                buffer = word_buffer;
             }
+            int i;
             if (bp < 4) {
-                int i;
                 while_dbra_count(i, line_words) {
                     bitmap[bp + i * 4] = buffer[i];
+                    hton(bitmap[bp + i * 4]);
+                }
+            } else {
+                while_dbra_count(i, line_words) {
+                    maskmap[i] = buffer[i];
+                    hton(maskmap[i]);
                 }
             }
         }
@@ -149,26 +156,62 @@ static void image_read(iffstream_c& file, uint16_t line_words, int height, uint1
     }
 }
 
-static void image_read_packbits(iffstream_c& file, uint16_t line_words, int height, uint16_t* bitmap, uint16_t* maskmap) {
+namespace {
+    // Packed bytes straight out of a stream view.
+    struct view_source_s {
+        const uint8_t* ptr;
+        const uint8_t* const end;
+        __forceinline bool read(uint8_t* buf, int count) {
+            if (end - ptr < count) {
+                return false;
+            }
+            memcpy(buf, ptr, count);
+            ptr += count;
+            return true;
+        }
+        __forceinline bool read(uint8_t& byte) {
+            if (ptr == end) {
+                return false;
+            }
+            byte = *ptr++;
+            return true;
+        }
+    };
+
+    // Packed bytes read one run at a time from the stream.
+    struct stream_source_s {
+        iffstream_c& file;
+        __forceinline bool read(uint8_t* buf, int count) {
+            return file.read(buf, count) == static_cast<size_t>(count);
+        }
+        __forceinline bool read(uint8_t& byte) {
+            return file.read(&byte, 1) == 1;
+        }
+    };
+}
+
+template<class Source>
+static void image_unpack_packbits(Source& source, uint16_t line_words, int height, uint16_t* bitmap, uint16_t* maskmap) {
     const int bp_count = (maskmap ? 5 : 4);
     uint16_t word_buffer[line_words * bp_count];
     while_dbra_count(height, height) {
         uint8_t* buffer = (uint8_t*)word_buffer;
         uint8_t* bufferEnd = buffer + (line_words * bp_count * 2);
         while (buffer < bufferEnd) {
-            int8_t cmd;
-            if (!file.read((uint8_t*)&cmd, 1)) {
+            uint8_t cmd_byte;
+            if (!source.read(cmd_byte)) {
                 return; // Failed read
             }
+            int8_t cmd = static_cast<int8_t>(cmd_byte);
             if (cmd >= 0) {
                 const int to_read = cmd + 1;
-                if (!file.read(buffer, to_read)) {
+                if (!source.read(buffer, to_read)) {
                     return; // Failed read
                 }
                 buffer += to_read;
             } else if (cmd != -128) {
                 uint8_t data;
-                if (!file.read(&data, 1)) {
+                if (!source.read(data)) {
                     return; // Failed read
                 }
                 while (cmd++ <= 0) {
@@ -198,43 +241,66 @@ static void image_read_packbits(iffstream_c& file, uint16_t line_words, int heig
     }
 }
 
+static void image_read_packbits(iffstream_c& file, size_t size, uint16_t line_words, int height, uint16_t* bitmap, uint16_t* maskmap) {
+    const uint8_t* packed = file.view(size);
+    if (packed) {
+        view_source_s source{ packed, packed + size };
+        image_unpack_packbits(source, line_words, height, bitmap, maskmap);
+    } else {
+        stream_source_s source{ file };
+        image_unpack_packbits(source, line_words, height, bitmap, maskmap);
+    }
+}
+
 image_c::image_c(const char* path, int masked_cidx, const iffstream_c::unknown_reader& unknown_reader) :
     _palette(nullptr), _bitmap(nullptr), _maskmap(nullptr), _size(), _line_words(0)
 {
     bool masked = false;
     iffstream_c file(path);
-    iff_group_s form;
-    if (!file.good() || !file.first(cc4::FORM, ::cc4::ILBM, form)) {
+    if (!file.good()) {
         if (errno == 0) {
             errno = EINVAL;
         }
+        return; // Could not open
+    }
+    // Index once, so BMHD is known before BODY regardless of chunk order.
+    iff_index_c index(file);
+    const auto* form = index.first(cc4::FORM, ::cc4::ILBM);
+    const auto* header = form ? index.first(*form, ::cc4::BMHD) : nullptr;
+    if (header == nullptr) {
+        errno = EINVAL;
         return; // Not a ILBM
     }
-    iff_chunk_s chunk;
     ilbm_header_s bmhd;
-    while (file.next(form, cc4::ANY, chunk)) {
-        if (chunk.id == ::cc4::BMHD) {
-            if (!file.read(&bmhd)) {
-                errno = EINVAL;
-                return;
-            }
-            _size = bmhd.size;
-            assert(bmhd.plane_count == 4 && "Only 4-plane images are supported");
-            if (masked_cidx != MASKED_CIDX) {
-                assert(bmhd.mask_type != mask_type_e::plane && "Plane mask type conflicts with custom mask color");
-                bmhd.mask_color = masked_cidx;
-                masked = true;
-            } else if (bmhd.mask_type == mask_type_e::color) {
-                masked_cidx = bmhd.mask_color;
-                masked = true;
-            } else if (bmhd.mask_type == mask_type_e::plane) {
-                masked = true;
-            } else {
-                assert(bmhd.mask_type == mask_type_e::none && "Mask type must be none when not using color or plane masks");
-            }
-            // DeluxePain ST format and custom deflate not supported
-            assert(bmhd.compression_type < compression_type_e::vertical && "DeluxePaint ST vertical compression not supported");
-        } else if (chunk.id == ::cc4::CMAP) {
+    if (!file.reset(*header) || !file.read(&bmhd)) {
+        errno = EINVAL;
+        return;
+    }
+    _size = bmhd.size;
+    assert(bmhd.plane_count == 4 && "Only 4-plane images are supported");
+    if (masked_cidx != MASKED_CIDX) {
+        assert(bmhd.mask_type != mask_type_e::plane && "Plane mask type conflicts with custom mask color");
+        bmhd.mask_color = masked_cidx;
+        masked = true;
+    } else if (bmhd.mask_type == mask_type_e::color) {
+        masked_cidx = bmhd.mask_color;
+        masked = true;
+    } else if (bmhd.mask_type == mask_type_e::plane) {
+        masked = true;
+    } else {
+        assert(bmhd.mask_type == mask_type_e::none && "Mask type must be none when not using color or plane masks");
+    }
+    // DeluxePain ST format not supported
+    assert(bmhd.compression_type != compression_type_e::vertical && "DeluxePaint ST vertical compression not supported");
+#if !TOYBOX_ILBM_SUPPORTS_DEFLATE
+    assert(bmhd.compression_type != compression_type_e::deflate && "Deflate compression not enabled");
+#endif
+    for (auto entry = index.first(*form, cc4::ANY); entry; entry = index.next(*entry, cc4::ANY)) {
+        iff_chunk_s chunk = *entry;
+        if (chunk.id == ::cc4::BMHD || !file.reset(chunk)) {
+            continue;
+        }
+        if (chunk.id == ::cc4::CMAP) {
             uint8_t cmpa[48];
             if (file.read(cmpa, 48) != 48) {
                 errno = EINVAL;
@@ -258,8 +324,16 @@ image_c::image_c(const char* path, int masked_cidx, const iffstream_c::unknown_r
                     image_read(file, _line_words, _size.height, _bitmap.get(), bmhd.mask_type == mask_type_e::plane ? _maskmap : nullptr);
                     break;
                 case compression_type_e::packbits:
-                    image_read_packbits(file, _line_words, _size.height, _bitmap.get(), bmhd.mask_type == mask_type_e::plane ? _maskmap : nullptr);
+                    image_read_packbits(file, chunk.size, _line_words, _size.height, _bitmap.get(), bmhd.mask_type == mask_type_e::plane ? _maskmap : nullptr);
+                    break;
+#if TOYBOX_ILBM_SUPPORTS_DEFLATE
+                case compression_type_e::deflate: {
+                    // Rows are inflated through the same row buffer as uncompressed BODY chunks.
+                    inflate_stream_c inflated(file);
+                    image_read(inflated, _line_words, _size.height, _bitmap.get(), bmhd.mask_type == mask_type_e::plane ? _maskmap : nullptr);
                     break;
+                }
+#endif
                 default:
                     break;
             }
@@ -279,12 +353,11 @@ image_c::image_c(const char* path, int masked_cidx, const iffstream_c::unknown_r
             if (unknown_reader) {
                skip = !unknown_reader(file, chunk);
             }
-            if (skip) {
 #ifndef __M68000__
+            if (skip) {
                 printf("Skipping '%s'\n", chunk.id.cstring());
-#endif
-                file.skip(chunk);
             }
+#endif
         }
     }
 }
@@ -421,10 +494,42 @@ static void image_write_packbits(iffstream_c& file, uint16_t line_words, uint16_
     }
 }
 
+#if TOYBOX_ILBM_SUPPORTS_DEFLATE && !defined(__M68000__)
+static bool image_write_deflate(iffstream_c& file, uint16_t line_words, uint16_t next_line_words, int height, uint16_t* bitmap, uint16_t* maskmap) {
+    // Same row layout as uncompressed, deflated as one zlib stream.
+    const int bp_count = (maskmap ? 5 : 4);
+    const size_t row_words = line_words * bp_count;
+    const size_t body_size = row_words * 2 * height;
+    unique_ptr_c<uint16_t> body(static_cast<uint16_t*>(_malloc(body_size)));
+    if (!body) {
+        errno = ENOMEM;
+        return false;
+    }
+    uint16_t* row = body.get();
+    while_dbra_count(height, height) {
+        for (int bp = 0; bp < bp_count; bp++) {
+            for (int i = 0; i < line_words; i++) {
+                row[bp * line_words + i] = bp < 4 ? bitmap[bp + i * 4] : maskmap[i];
+                hton(row[bp * line_words + i]);
+            }
+        }
+        row += row_words;
+        bitmap += next_line_words * 4;
+        if (maskmap) {
+            maskmap += next_line_words;
+        }
+    }
+    if (deflate(file, reinterpret_cast<const uint8_t*>(body.get()), body_size) == 0) {
+        errno = EIO;
+        return false;
+    }
+    return true;
+}
+#endif
 
 bool image_c::save(const char* path, image_c::compression_type_e compression, bool masked, int masked_cidx, const iffstream_c::unknown_writer& unknown_writer) {
-    // DeluxePain ST format and custom deflate not supported
-    assert(compression < compression_type_e::vertical && "DeluxePaint ST vertical compression not supported");
+    // DeluxePain ST format not supported
+    assert(compression != compression_type_e::vertical && "DeluxePaint ST vertical compression not supported");
 
     iffstream_c ilbm(path, fstream_c::openmode_e::input | fstream_c::openmode_e::output);
     if (ilbm.tell() >= 0) {
@@ -477,9 +582,11 @@ bool image_c::save(const char* path, image_c::compression_type_e compression, bo
                 case compression_type_e::packbits:
                     image_write_packbits(ilbm, (_size.width + 15) / 16, _line_words, _size.height, _bitmap.get(), header.mask_type == mask_type_e::plane ? _maskmap : nullptr);
                     break;
-#if TOYBOX_ILBM_SUPPORTS_DEFLATE
+#if TOYBOX_ILBM_SUPPORTS_DEFLATE && !defined(__M68000__)
                 case compression_type_e::deflate:
-                    image_write_deflate(ilbm, (_size.width + 15) / 16, _line_words, _size.height, _bitmap.get(), header.mask_type == mask_type_plane ? _maskmap : nullptr);
+                    if (!image_write_deflate(ilbm, (_size.width + 15) / 16, _line_words, _size.height, _bitmap.get(), header.mask_type == mask_type_e::plane ? _maskmap : nullptr)) {
+                        return false;
+                    }
                     break;
 #endif
                 default:
@@ -11,11 +11,254 @@
 #include "media/font.hpp"
 #include "media/audio.hpp"
 #include "core/expected.hpp"
+#include "core/memory_telemetry.hpp"
+#include "core/pack.hpp"
+#ifdef TOYBOX_HOST
+#include "core/ring_buffer.hpp"
+#include <pthread.h>
+#endif
 
 using namespace toybox;
 
 static unique_ptr_c<asset_manager_c> s_shared;
 
+namespace toybox::detail {
+
+    /**
+     Reads one whole file at a time into a `_malloc` buffer, without blocking
+     the main loop. On host a worker thread reads the file, on target each
+     `poll()` reads a bounded slice of the file.
+     Files in the mounted `pack_c` are read from the pack.
+     */
+    class asset_loader_c : public nocopy_c {
+    public:
+        asset_loader_c();
+        ~asset_loader_c();
+
+        /// Id of the asset being loaded, or -1 if idle.
+        __forceinline int id() const __pure { return _id; }
+        __forceinline bool done() const __pure { return _done; }
+        void start(int id, const char* path);
+        /// Advances loading, returns true when done, or the read failed.
+        bool poll(size_t budget, bool wait);
+        /// Returns the read data and becomes idle, nullptr if the read failed.
+        uint8_t* take(size_t& size);
+        /// Discards any load in progress and becomes idle.
+        void cancel();
+
+    private:
+        int _id;
+        bool _done;
+        uint8_t* _data;
+        size_t _size;
+#ifdef TOYBOX_HOST
+        struct job_s {
+            const char* path;
+            long offset;
+            long size;      // Negative for the whole file
+            uint8_t* data;
+        };
+        static void* worker(void* arg);
+        static void read_file(job_s& job);
+
+        ring_buffer_c<job_s, 2> _requested;
+        ring_buffer_c<job_s, 2> _completed;
+        pthread_t _thread;
+        pthread_mutex_t _mutex;
+        pthread_cond_t _cond;
+        bool _quit;
+#else
+        shared_ptr_c<stream_c> _stream;
+        size_t _pos;
+#endif
+    };
+
+}
+
+using detail::asset_loader_c;
+
+#ifdef TOYBOX_HOST
+
+asset_loader_c::asset_loader_c() : _id(-1), _done(false), _data(nullptr), _size(0), _quit(false) {
+    pthread_mutex_init(&_mutex, nullptr);
+    pthread_cond_init(&_cond, nullptr);
+    hard_assert(pthread_create(&_thread, nullptr, &worker, this) == 0);
+}
+
+asset_loader_c::~asset_loader_c() {
+    cancel();
+    pthread_mutex_lock(&_mutex);
+    _quit = true;
+    pthread_cond_broadcast(&_cond);
+    pthread_mutex_unlock(&_mutex);
+    pthread_join(_thread, nullptr);
+    pthread_cond_destroy(&_cond);
+    pthread_mutex_destroy(&_mutex);
+}
+
+void* asset_loader_c::worker(void* arg) {
+    auto& loader = *static_cast<asset_loader_c*>(arg);
+    pthread_mutex_lock(&loader._mutex);
+    while (!loader._quit) {
+        job_s job;
+        if (loader._requested.pop(job)) {
+            pthread_mutex_unlock(&loader._mutex);
+            read_file(job);
+            pthread_mutex_lock(&loader._mutex);
+            loader._completed.push(job);
+            pthread_cond_broadcast(&loader._cond);
+        } else {
+            pthread_cond_wait(&loader._cond, &loader._mutex);
+        }
+    }
+    pthread_mutex_unlock(&loader._mutex);
+    return nullptr;
+}
+
+void asset_loader_c::read_file(job_s& job) {
+    // Only _malloc and stdio on this thread, operator new is not thread safe.
+    // Packs are opened again, the stream of the mounted pack is not thread safe.
+    long size = job.size;
+    job.data = nullptr;
+    job.size = 0;
+    FILE* file = _fopen(job.path, "rb");
+    if (file == nullptr) {
+        return;
+    }
+    if (size < 0 && fseek(file, 0, SEEK_END) == 0) {
+        size = ftell(file);
+    }
+    if (size >= 0 && fseek(file, job.offset, SEEK_SET) == 0) {
+        uint8_t* data = static_cast<uint8_t*>(_malloc(MAX(size, 1)));
+        if (data && fread(data, 1, size, file) == static_cast<size_t>(size)) {
+            job.data = data;
+            job.size = size;
+        } else if (data) {
+            _free(data);
+        }
+    }
+    fclose(file);
+}
+
+void asset_loader_c::start(int id, const char* path) {
+    assert(_id < 0 && "Loader is busy");
+    _id = id;
+    _done = false;
+    job_s job = { path, 0, -1, nullptr };
+    const auto* pack = pack_c::mounted();
+    if (const auto* entry = pack ? pack->find(path) : nullptr) {
+        job = { pack->path(), static_cast<long>(entry->offset), static_cast<long>(entry->size), nullptr };
+    }
+    pthread_mutex_lock(&_mutex);
+    _requested.push(job);
+    pthread_cond_broadcast(&_cond);
+    pthread_mutex_unlock(&_mutex);
+}
+
+bool asset_loader_c::poll(size_t budget, bool wait) {
+    assert(_id >= 0 && !_done && "Loader is not loading");
+    pthread_mutex_lock(&_mutex);
+    job_s job;
+    bool done;
+    while (!(done = _completed.pop(job)) && wait) {
+        pthread_cond_wait(&_cond, &_mutex);
+    }
+    pthread_mutex_unlock(&_mutex);
+    if (done) {
+        _data = job.data;
+        _size = job.size;
+        _done = true;
+    }
+    return done;
+}
+
+#else
+
+asset_loader_c::asset_loader_c() : _id(-1), _done(false), _data(nullptr), _size(0), _stream(), _pos(0) {}
+
+asset_loader_c::~asset_loader_c() {
+    cancel();
+}
+
+void asset_loader_c::start(int id, const char* path) {
+    assert(_id < 0 && "Loader is busy");
+    _id = id;
+    _done = false;
+    _pos = 0;
+    const auto* pack = pack_c::mounted();
+    _stream = pack ? pack->open(path) : shared_ptr_c<stream_c>();
+    if (!_stream) {
+        auto* file = new fstream_c(path);
+        if (file->is_open()) {
+            _stream.reset(file);
+        } else {
+            delete file;
+        }
+    }
+    if (_stream) {
+        _stream->seek(0, stream_c::seekdir_e::end);
+        const ptrdiff_t size = _stream->tell();
+        if (size >= 0) {
+            _size = size;
+            _data = static_cast<uint8_t*>(_malloc(MAX(_size, 1)));
+        }
+    }
+}
+
+bool asset_loader_c::poll(size_t budget, bool wait) {
+    assert(_id >= 0 && !_done && "Loader is not loading");
+    if (_data) {
+        const size_t count = wait ? _size - _pos : MIN(budget, _size - _pos);
+        // Other reads may have moved a shared pack stream since the last slice.
+        _stream->seek(_pos, stream_c::seekdir_e::beg);
+        if (_stream->read(_data + _pos, count) != count) {
+            _free(_data);
+            _data = nullptr;
+        } else {
+            _pos += count;
+        }
+    }
+    if (_data == nullptr || _pos == _size) {
+        _stream.reset();
+        _done = true;
+        return true;
+    }
+    return false;
+}
+
+#endif
+
+uint8_t* asset_loader_c::take(size_t& size) {
+    assert(_done && "Loader is not done");
+    uint8_t* data = _data;
+    size = _size;
+    _id = -1;
+    _done = false;
+    _data = nullptr;
+    _size = 0;
+    return data;
+}
+
+void asset_loader_c::cancel() {
+    if (_id < 0) {
+        return;
+    }
+    if (!_done) {
+#ifdef TOYBOX_HOST
+        // The worker can not be interrupted, wait for it.
+        poll(0, true);
+#else
+        _stream.reset();
+        _done = true;
+#endif
+    }
+    size_t size;
+    uint8_t* data = take(size);
+    if (data) {
+        _free(data);
+    }
+}
+
 asset_manager_c& asset_manager_c::shared() {
     static asset_manager_c s_shared;
     return s_shared;
@@ -23,7 +266,31 @@ asset_manager_c& asset_manager_c::shared() {
 
 asset_manager_c::asset_manager_c() {}
 
-void asset_manager_c::preload(asset_set_t sets, progress_f progress) {
+asset_manager_c::~asset_manager_c() {
+    // A queued job reads _load_path, stop the loader before it is freed.
+    _loader.reset();
+}
+
+bool asset_manager_c::open_pack(const char* file) {
+    if (_loader && _loader->id() >= 0) {
+        // The load in progress may be reading from the current pack.
+        if (!_loader->done()) {
+            _loader->poll(0, true);
+        }
+        finish_load();
+    }
+    _pack.reset();
+    auto path = data_path(file);
+    unique_ptr_c<pack_c> pack(new pack_c(path.get()));
+    if (!pack->good()) {
+        return false;
+    }
+    pack_c::mount(pack.get());
+    _pack = move(pack);
+    return true;
+}
+
+void asset_manager_c::preload(asset_set_t sets, const progress_f& progress) {
     int ids[_asset_defs.size()];
     int count = 0;
     int id = 0;
@@ -45,24 +312,133 @@ void asset_manager_c::unload(asset_set_t sets) {
     int id = 0;
     for (auto& def : _asset_defs) {
         if ((def.sets & sets)) {
-            _assets[id].reset();
+            unload(id);
         }
         id++;
     }
 }
 
 void asset_manager_c::unload(int id) {
+    for (int i = _requests.size(); --i >= 0; ) {
+        if (_requests[i] == id) {
+            _requests.erase(i);
+        }
+    }
+    if (_loader && _loader->id() == id) {
+        _loader->cancel();
+        _load_path.reset();
+    }
     _assets[id].reset();
 }
 
 asset_c& asset_manager_c::asset(int id) const {
     auto& asset = _assets[id];
     if (asset.get() == nullptr) {
-        asset.reset(create_asset(id, _asset_defs[id]));
+        if (_loader && _loader->id() == id) {
+            // Requested and already loading, finish it now.
+            if (!_loader->done()) {
+                _loader->poll(0, true);
+            }
+            finish_load();
+        }
+        if (asset.get() == nullptr) {
+            const auto& def = _asset_defs[id];
+            auto path = def.file ? data_path(def.file) : nullptr;
+            create(id, path.get());
+        }
     }
     return *asset;
 }
 
+void asset_manager_c::create(int id, const char* path) const {
+    static const char* s_labels[] = {
+        "asset:custom", "asset:image", "asset:tileset", "asset:font", "asset:sound", "asset:music", "asset:level"
+    };
+    const auto& def = _asset_defs[id];
+    memory_telemetry_c::with_label(s_labels[(int)def.type], [&] {
+        _assets[id].reset(create_asset(id, def, path));
+    });
+}
+
+void asset_manager_c::request(asset_set_t sets) {
+    if (!_loader) {
+        _loader.reset(new detail::asset_loader_c());
+    }
+    int id = 0;
+    for (auto& def : _asset_defs) {
+        if ((def.sets & sets) && !ready(id) && _loader->id() != id) {
+            auto it = find_if(_requests.begin(), _requests.end(), [id](int16_t r) { return r == id; });
+            if (it == _requests.end()) {
+                _requests.push_back(id);
+            }
+        }
+        id++;
+    }
+}
+
+bool asset_manager_c::update(size_t budget) {
+    if (!_loader) {
+        return true;
+    }
+    if (_loader->id() < 0 && !start_load()) {
+        return true;
+    }
+    if (_loader->id() >= 0 && (_loader->done() || _loader->poll(budget, false))) {
+        finish_load();
+        // Start the next file now, so the host worker is never idle between frames.
+        start_load();
+    }
+    return _loader->id() < 0 && _requests.size() == 0;
+}
+
+bool asset_manager_c::ready(asset_set_t sets) const {
+    int id = 0;
+    for (auto& def : _asset_defs) {
+        if ((def.sets & sets) && !ready(id)) {
+            return false;
+        }
+        id++;
+    }
+    return true;
+}
+
+bool asset_manager_c::start_load() {
+    while (_requests.size() > 0) {
+        const int id = _requests.front();
+        _requests.erase(0);
+        if (ready(id)) {
+            continue;
+        }
+        const auto& def = _asset_defs[id];
+        if (def.file == nullptr) {
+            // Nothing to read, create it directly.
+            create(id, nullptr);
+        } else {
+            _load_path = data_path(def.file);
+            _loader->start(id, _load_path.get());
+        }
+        return true;
+    }
+    return false;
+}
+
+void asset_manager_c::finish_load() const {
+    const int id = _loader->id();
+    size_t size;
+    uint8_t* data = _loader->take(size);
+    if (_assets[id].get() == nullptr) {
+        // Parsers opening the path with a memstream_c take the data without reading.
+        if (data) {
+            memstream_c::prefetch(_load_path.get(), data, size);
+        }
+        create(id, _load_path.get());
+        memstream_c::prefetch(nullptr, nullptr, 0);
+    } else if (data) {
+        _free(data);
+    }
+    _load_path.reset();
+}
+
 void asset_manager_c::add_asset_def(int id, const asset_def_s& def) {
     while (_asset_defs.size() <= id) {
         _asset_defs.emplace_back(asset_c::custom, 0);
@@ -101,22 +477,21 @@ unique_ptr_c<char> asset_manager_c::user_path(const char* file) const {
     return path;
 }
 
-asset_c* asset_manager_c::create_asset(int id, const asset_def_s& def) const {
-    auto path = def.file ? data_path(def.file) : nullptr;
+asset_c* asset_manager_c::create_asset(int id, const asset_def_s& def, const char* path) const {
     if (def.create) {
-        return def.create(*this, path.get());
+        return def.create(*this, path);
     } else {
         switch (def.type) {
             case asset_c::image:
-                return expected_cast(new expected_c<image_c>(failable, path.get()));
+                return expected_cast(new expected_c<image_c>(failable, path));
             case asset_c::tileset:
-                return expected_cast(new expected_c<tileset_c>(failable, path.get(), size_s(16, 16)));
+                return expected_cast(new expected_c<tileset_c>(failable, path, size_s(16, 16)));
             case asset_c::font:
-                return expected_cast(new expected_c<font_c>(failable, path.get(), size_s(8, 8)));
+                return expected_cast(new expected_c<font_c>(failable, path, size_s(8, 8)));
             case asset_c::sound:
-                return expected_cast(new expected_c<sound_c>(failable, path.get()));
+                return expected_cast(new expected_c<sound_c>(failable, path));
             case asset_c::music:
-                return expected_cast(new expected_c<music_c>(failable, path.get()));
+                return expected_cast(new expected_c<music_c>(failable, path));
             case asset_c::tilemap_level:
                 // TODO: Implement file format and loading.
                 return nullptr;
@@ -11,7 +11,7 @@ namespace toybox {
 
     void set_frame_index(const tilemap_level_c& level, const entity_s& entity, uint8_t index, resize_origin_e origin = resize_origin_e::none);
     
-    frect_s entity_position_with_frame_index(const tilemap_level_c& level, const entity_s& entity, uint8_t index, resize_origin_e origin) {
+    entity_s::rect_t entity_position_with_frame_index(const tilemap_level_c& level, const entity_s& entity, uint8_t index, resize_origin_e origin) {
         const auto& ent_def = level.entity_type_defs()[entity.type].frame_defs[index];
         // TODO: Calculate actual new position rect here
         return entity.position;
@@ -6,8 +6,10 @@
 //
 
 #include "runtime/scene.hpp"
+#include "runtime/assets.hpp"
 #include "machine/machine.hpp"
 #include "core/algorithm.hpp"
+#include "core/memory_telemetry.hpp"
 
 using namespace toybox;
 
@@ -85,6 +87,13 @@ void scene_manager_c::run(unique_ptr_c<scene_c> rootscene, unique_ptr_c<transiti
     int32_t previous_tick = vbl.tick();
     while (_scene_stack.size() > 0) {
         vbl.wait();
+        // Transient allocations from previous frame are released here.
+        frame_arena_c::reset();
+#if TOYBOX_MEMORY_TELEMETRY
+        memory_telemetry_c::begin_frame();
+#endif
+        // Advance background loading of requested assets, if any.
+        asset_manager_c::shared().update();
         int32_t tick = vbl.tick();
         int32_t ticks = tick - previous_tick;
         previous_tick = tick;
@@ -124,6 +133,9 @@ void scene_manager_c::run(unique_ptr_c<scene_c> rootscene, unique_ptr_c<transiti
 }
 
 void scene_manager_c::push(unique_ptr_c<scene_c> scene, unique_ptr_c<transition_c> transition) {
+#if TOYBOX_MEMORY_TELEMETRY
+    memory_telemetry_c::print_report("scene_manager_c::push()");
+#endif
     scene_c* from = nullptr;
     if (_scene_stack.size() > 0) {
         from = &top_scene();
@@ -135,6 +147,9 @@ void scene_manager_c::push(unique_ptr_c<scene_c> scene, unique_ptr_c<transition_
 }
 
 void scene_manager_c::pop(unique_ptr_c<transition_c> transition, int count) {
+#if TOYBOX_MEMORY_TELEMETRY
+    memory_telemetry_c::print_report("scene_manager_c::pop()");
+#endif
     scene_c* from = nullptr;
     while (count-- > 0) {
         from = &top_scene();
@@ -161,15 +176,18 @@ void scene_manager_c::replace(unique_ptr_c<scene_c> scene, unique_ptr_c<transiti
 
 // Add new required lists
 static shared_ptr_c<display_list_c> make_display_list(const scene_c::configuration_s& configuration) {
-    shared_ptr_c<display_list_c> listptr(new display_list_c());
-    auto pal = new palette_c();
-    if (configuration.palette) {
-        copy(configuration.palette->begin(), configuration.palette->end(), pal->begin());
-    }
-    auto vpt = new viewport_c(configuration.viewport_size);
-    vpt->set_offset(point_s(0,0));
-    listptr->emplace_front(PRIMARY_PALETTE, -1, pal);
-    listptr->emplace_front(PRIMARY_VIEWPORT, -1, vpt);
+    shared_ptr_c<display_list_c> listptr;
+    memory_telemetry_c::with_label("display_list", [&] {
+        listptr = shared_ptr_c<display_list_c>(new display_list_c());
+        auto pal = new palette_c();
+        if (configuration.palette) {
+            copy(configuration.palette->begin(), configuration.palette->end(), pal->begin());
+        }
+        auto vpt = new viewport_c(configuration.viewport_size);
+        vpt->set_offset(point_s(0,0));
+        listptr->emplace_front(PRIMARY_PALETTE, -1, pal);
+        listptr->emplace_front(PRIMARY_VIEWPORT, -1, vpt);
+    });
     return listptr;
 }
 
@@ -44,7 +44,7 @@ pair_c<int, entity_type_def_s&> tilemap_level_c::add_entity_type_def(tileset_c*
     return {i, _entity_type_defs.emplace_back(tileset)};
 }
 
-entity_s& tilemap_level_c::spawn_entity(uint8_t type, uint8_t group, frect_s position) {
+entity_s& tilemap_level_c::spawn_entity(uint8_t type, uint8_t group, entity_s::rect_t position) {
     const uint8_t new_id = _all_entities.size() ? _all_entities.back().id + 1 : 0;
     auto& entity = _all_entities.emplace_back();
     entity.id = new_id;
@@ -241,25 +241,23 @@ tile_s::type_e tilemap_level_c::collides_with_level(uint8_t id) const {
     return collides_with_level(entity.position);
 }
 
-tile_s::type_e tilemap_level_c::collides_with_level(fpoint_s at) const {
-    point_s iat(at);
-    const auto& tile = (*this)[iat.x >> 4, iat.y >> 4];
+tile_s::type_e tilemap_level_c::tile_type_at(point_s pixel_at) const {
+    const auto& tile = (*this)[pixel_at.x >> 4, pixel_at.y >> 4];
     return tile.type;
 }
 
-tile_s::type_e tilemap_level_c::collides_with_level(const frect_s& rect) const {
-    const auto pixel_rect = static_cast<rect_s>(rect);
+tile_s::type_e tilemap_level_c::max_tile_type_in(const rect_s& pixel_rect) const {
     assert(pixel_rect.contained_by(_visible_bounds) && "Rect must be in visible bounds");
     // Tile coordinate bounds
-    const auto tile_x_min = pixel_rect.origin.x >> 4;
-    const auto tile_y_min = pixel_rect.origin.y >> 4;
-    const auto tile_x_max = pixel_rect.max_x() >> 4;
-    const auto tile_y_max = pixel_rect.max_y() >> 4;
+    const int16_t tile_x_min = pixel_rect.origin.x >> 4;
+    const int16_t tile_y_min = pixel_rect.origin.y >> 4;
+    const int16_t tile_x_max = pixel_rect.max_x() >> 4;
+    const int16_t tile_y_max = pixel_rect.max_y() >> 4;
+    const rect_s tile_rect(tile_x_min, tile_y_min, tile_x_max - tile_x_min + 1, tile_y_max - tile_y_min + 1);
     // Check each tile in the rect's coverage area
     tile_s::type_e max_type = tile_s::none;
-    for (int16_t y = tile_y_min; y <= tile_y_max; ++y) {
-        for (int16_t x = tile_x_min; x <= tile_x_max; ++x) {
-            const auto& tile = (*this)[x, y];
+    for (const auto row : tiles_span().subspan(tile_rect)) {
+        for (const auto& tile : row) {
             max_type = max(max_type, tile.type);
         }
     }
@@ -284,20 +282,26 @@ bool tilemap_level_c::collides_with_entity(uint8_t id, uint8_t in_group, uint8_t
     return false;
 }
 
-bool tilemap_level_c::collides_with_entity(const frect_s& rect, uint8_t in_group, uint8_t* id_out) const {
+template<class Coord>
+bool tilemap_level_c::collides_with_entity(const base_rect_s<Coord>& rect, uint8_t in_group, uint8_t* id_out) const {
     assert(id_out != nullptr && "id_out must not be null");
+    // Compare in the wider of the query and entity coordinate types, so no position overflows
+    using wide_rect_t = base_rect_s<typename conditional<(sizeof(Coord) > sizeof(entity_s::coord_t)), Coord, entity_s::coord_t>::type>;
+    const auto wide_rect = static_cast<wide_rect_t>(rect);
     // Iterate through all entities and check for collisions with matching group
     for (int idx = 0; idx < _all_entities.size(); ++idx) {
         const auto& entity = _all_entities[idx];
         if (entity.group != in_group) continue;
         if (!entity.active) continue;
-        if (rect.intersects(entity.position)) {
+        if (wide_rect.intersects(static_cast<wide_rect_t>(entity.position))) {
             *id_out = (uint8_t)idx;
             return true;
         }
     }
     return false;
 }
+template bool tilemap_level_c::collides_with_entity(const frect_s& rect, uint8_t in_group, uint8_t* id_out) const;
+template bool tilemap_level_c::collides_with_entity(const frect32_s& rect, uint8_t in_group, uint8_t* id_out) const;
 
 void tilemap_level_c::set_visible_bounds(const rect_s& bounds) {
     // TODO: When changing bounds columns (and eventually rows) of tiles needs to be marked dirty.
@@ -316,10 +320,9 @@ void tilemap_level_c::splice_subtilemap(int index) {
     const auto& bounds = tilemap.tilespace_bounds();
     assert(bounds.contained_by(tilespace_bounds()));
     point_s at = bounds.origin;
-    for (int y = 0; y < bounds.size.height; ++y) {
+    for (auto row : tilemap.tiles_span()) {
         at.x = bounds.origin.x;
-        for (int x = 0; x < bounds.size.width; ++x) {
-            auto& tile = tilemap[x,y];
+        for (auto& tile : row) {
             splice_tile(tile, at);
             ++at.x;
         }
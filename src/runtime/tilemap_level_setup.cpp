@@ -42,11 +42,20 @@ tilemap_c(rect_s()), _is_initialized(false)
             file.read((uint8_t*)name, chunk.size);
             _name.reset(name);
         } else if (chunk.id == detail::cc4::ENTS) {
-            assert(header.entity_count * sizeof(entity_s) == chunk.size);
+            assert(header.entity_count * sizeof(detail::entity_record_s) == chunk.size);
             _all_entities.reserve(header.entity_count + 16);
             for (int i = 0; i < header.entity_count; ++i) {
                 auto& entity = _all_entities.emplace_back();
+#if TOYBOX_ENTITY_FIX32
+                detail::entity_record_s record;
+                file.read(&record);
+                memcpy(&entity, record.fields, sizeof(record.fields));
+                const auto& pos = record.position;
+                entity.position = entity_s::rect_t(fix32_t(pos.origin.x), fix32_t(pos.origin.y), fix32_t(pos.size.width), fix32_t(pos.size.height));
+                memcpy(entity.reserved_data, record.reserved_data, sizeof(entity.reserved_data));
+#else
                 file.read(&entity);
+#endif
             }
         } else if (chunk.id == cc4::LIST) {
             iff_group_s list;
@@ -57,13 +57,26 @@ struct non_trivial_s {
 // Test function declarations
 void test_array_and_vector();
 void test_map();
+void test_hash_map();
 void test_dynamic_vector();
+void test_small_vector();
+void test_relocatable_vector();
 void test_list();
+void test_intrusive_list();
+void test_span2d();
+void test_ring_buffer();
 void test_display_list();
 void test_algorithms();
 void test_math();
 void test_math_functions();
+void test_math_tables();
+void test_rand_stream();
 void test_lifetime();
 void test_shared_ptr();
+void test_frame_arena();
+void test_slab_allocator();
+void test_pool_allocator();
+void test_memory_telemetry();
 void test_optionset();
 void test_bitset();
+void test_stream();
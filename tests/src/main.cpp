@@ -11,8 +11,14 @@ int main(int argc, const char* argv[]) {
     // Test collections
     test_array_and_vector();
     test_dynamic_vector();
+    test_small_vector();
+    test_relocatable_vector();
     test_list();
+    test_intrusive_list();
+    test_span2d();
+    test_ring_buffer();
     test_map();
+    test_hash_map();
     
     // Test display list
     // Disable for now, display list destruction now requires the maschine_s singleton to be alive.
@@ -24,17 +30,26 @@ int main(int argc, const char* argv[]) {
     // Test math, especially fix16_t
     test_math();
     test_math_functions();
+    test_math_tables();
+    test_rand_stream();
     
     // Test copy/move works as expected to lifetimes
     test_lifetime();
 
     // Test shared_ptr
     test_shared_ptr();
+    test_frame_arena();
+    test_slab_allocator();
+    test_pool_allocator();
+    test_memory_telemetry();
 
     // Test optionset and bitset
     test_optionset();
     test_bitset();
 
+    // Test stream decorators
+    test_stream();
+
     printf("All pass.\n\r");
 #ifndef TOYBOX_HOST
     while (getc(stdin) != ' ');
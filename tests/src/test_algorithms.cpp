@@ -10,6 +10,155 @@
 #include "core/algorithm.hpp"
 #include "core/list.hpp"
 
+static uint16_t s_test_seed = 1;
+static int16_t test_random() {
+    s_test_seed = s_test_seed * 25173 + 13849;
+    return (int16_t)(s_test_seed >> 1);
+}
+
+struct sort_item_s {
+    int16_t key;
+    int16_t order;
+};
+
+#ifndef __M68000__
+struct layout_item_s {
+    uint8_t tag;
+    uint8_t flags;
+    uint16_t word;
+    uint32_t lng;
+    uint8_t pad[2];
+    uint16_t words[2];
+};
+template<>
+struct toybox::struct_layout<layout_item_s> {
+    static constexpr const char* value = "2b1w1l2b2w";
+};
+struct layout_bytes_s {
+    uint8_t bytes[4];
+};
+template<>
+struct toybox::struct_layout<layout_bytes_s> {
+    static constexpr const char* value = "4b";
+};
+
+__neverinline static void test_struct_layout() {
+    static_assert(detail::struct_swap_s<layout_item_s>::count == 4);
+    static_assert(detail::struct_swap_s<layout_item_s>::size == 14);
+    static_assert(detail::struct_swap_s<layout_item_s>::fields.field[1].offset == 4);
+    static_assert(detail::struct_swap_s<layout_item_s>::fields.field[1].size == 4);
+    static_assert(detail::struct_swap_s<layout_bytes_s>::count == 0);
+
+    layout_item_s items[3];
+    for (int i = 0; i < 3; i++) {
+        items[i] = { 1, 2, 0x1234, 0x12345678, { 3, 4 }, { 0x0102, static_cast<uint16_t>(0x0300 + i) } };
+    }
+    hton(items[0]);
+    hard_assert(items[0].tag == 1 && items[0].flags == 2 && "Bytes should not be swapped");
+    hard_assert(items[0].word == 0x3412 && items[0].lng == 0x78563412 && "Word and long should be swapped");
+    hard_assert(items[0].pad[0] == 3 && items[0].words[0] == 0x0201 && items[0].words[1] == 0x0003 && "Trailing words should be swapped");
+    hton(items);
+    hard_assert(items[0].word == 0x1234 && items[0].lng == 0x12345678 && "Swapping twice should restore values");
+    for (int i = 1; i < 3; i++) {
+        hard_assert(items[i].word == 0x3412 && items[i].words[1] == static_cast<uint16_t>((0x0300 + i) << 8 | 0x03) && "Arrays should swap every element");
+    }
+
+    layout_bytes_s bytes = { { 1, 2, 3, 4 } };
+    hton(&bytes, 1);
+    hard_assert(bytes.bytes[0] == 1 && bytes.bytes[3] == 4 && "Byte only layouts should be untouched");
+}
+#endif
+
+__neverinline static void test_sort_algorithms() {
+    constexpr int count = 300;
+    static int16_t values[count];
+    static int16_t scratch[count];
+    static sort_item_s items[count];
+    static sort_item_s item_scratch[count];
+    const auto less = [](int16_t a, int16_t b) { return a < b; };
+    
+    // Test introsort on random, sorted, reversed and equal input
+    for (int variant = 0; variant < 4; ++variant) {
+        for (int i = 0; i < count; ++i) {
+            switch (variant) {
+                case 0: values[i] = test_random(); break;
+                case 1: values[i] = i; break;
+                case 2: values[i] = count - i; break;
+                default: values[i] = 7; break;
+            }
+        }
+        sort(begin(values), end(values), less);
+        hard_assert(is_sorted(begin(values), end(values)) && "Introsort should sort");
+    }
+    
+    // Test stable sort keeps order of equal keys, with and without scratch
+    for (int variant = 0; variant < 2; ++variant) {
+        for (int i = 0; i < count; ++i) {
+            items[i] = { (int16_t)(test_random() & 15), (int16_t)i };
+        }
+        const auto key_less = [](const sort_item_s& a, const sort_item_s& b) { return a.key < b.key; };
+        if (variant == 0) {
+            stable_sort(begin(items), end(items), item_scratch, key_less);
+        } else {
+            stable_sort(begin(items), end(items), key_less);
+        }
+        for (int i = 1; i < count; ++i) {
+            hard_assert(items[i - 1].key <= items[i].key && "Stable sort should sort");
+            if (items[i - 1].key == items[i].key) {
+                hard_assert(items[i - 1].order < items[i].order && "Stable sort should keep order");
+            }
+        }
+    }
+
+    // Test radix sort with signed keys is sorted and stable
+    {
+        for (int i = 0; i < count; ++i) {
+            items[i] = { (int16_t)(test_random() % 500), (int16_t)i };
+        }
+        radix_sort(begin(items), end(items), item_scratch, [](const sort_item_s& item) {
+            return (uint16_t)(item.key ^ 0x8000);
+        });
+        for (int i = 1; i < count; ++i) {
+            hard_assert(items[i - 1].key <= items[i].key && "Radix sort should sort");
+            if (items[i - 1].key == items[i].key) {
+                hard_assert(items[i - 1].order < items[i].order && "Radix sort should keep order");
+            }
+        }
+        // Keys fitting in low byte only need a single pass
+        for (int i = 0; i < count; ++i) {
+            values[i] = test_random() & 0xff;
+        }
+        radix_sort(begin(values), end(values), scratch, [](int16_t v) { return (uint16_t)v; });
+        hard_assert(is_sorted(begin(values), end(values)) && "Single pass radix sort should sort");
+    }
+
+    // Test nth_element
+    for (int nth = 0; nth < count; nth += 37) {
+        for (int i = 0; i < count; ++i) {
+            values[i] = test_random();
+        }
+        nth_element(begin(values), begin(values) + nth, end(values));
+        const int16_t pivot = values[nth];
+        for (int i = 0; i < count; ++i) {
+            hard_assert((i < nth ? values[i] <= pivot : values[i] >= pivot) && "nth_element should partition around nth");
+        }
+        sort(begin(values), end(values));
+        hard_assert(values[nth] == pivot && "nth_element should place sorted value at nth");
+    }
+
+    // Test partition
+    {
+        for (int i = 0; i < count; ++i) {
+            values[i] = test_random();
+        }
+        const auto is_even = [](int16_t v) { return (v & 1) == 0; };
+        auto mid = partition(begin(values), end(values), is_even);
+        for (auto it = begin(values); it != end(values); ++it) {
+            hard_assert(is_even(*it) == (it < mid) && "Partition should group by predicate");
+        }
+    }
+}
+
 __neverinline void test_algorithms() {
     printf("== Start: test_algorithms\n\r");
     constexpr int numbers[4] = { 1, 7, 2, 0 };
@@ -45,5 +194,10 @@ __neverinline void test_algorithms() {
     move(list.begin(), list.end(), begin(buffer));
     hard_assert(buffer[0] == 0 && buffer[1] == 4 && buffer[2] == 5 && "Moved sorted list values should match");
 
+    test_sort_algorithms();
+#ifndef __M68000__
+    test_struct_layout();
+#endif
+
     printf("test_algorithms pass.\n\r");
 }
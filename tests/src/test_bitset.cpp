@@ -233,10 +233,97 @@ __neverinline static void __test_bitset_iterator() {
     hard_assert(*it == 5 && "after increment should be 5");
 }
 
+__neverinline static void __test_bitset_scan() {
+    // Tables used on target must agree with the host builtins
+    for (int i = 0; i < 256; ++i) {
+        hard_assert(detail::ctz_table.values[i] == (i ? __builtin_ctz(i) : 8) && "ctz table mismatch");
+        hard_assert(detail::popcount_table.values[i] == __builtin_popcount(i) && "popcount table mismatch");
+        hard_assert(detail::clz_table.values[i] == (i ? __builtin_clz(i) - 24 : 8) && "clz table mismatch");
+    }
+    hard_assert(countr_zero(0) == 32);
+    hard_assert(countr_zero(1) == 0);
+    hard_assert(countr_zero(0x80000000) == 31);
+    hard_assert(countr_zero(0x00010000) == 16);
+    hard_assert(countr_zero(0x00000300) == 8);
+    hard_assert(countl_zero(0) == 32);
+    hard_assert(countl_zero(1) == 31);
+    hard_assert(countl_zero(0x80000000) == 0);
+    hard_assert(countl_zero(0x00010000) == 15);
+    hard_assert(countl_zero(0x00000300) == 22);
+    hard_assert(popcount(0) == 0);
+    hard_assert(popcount(0xffffffff) == 32);
+    hard_assert(popcount(0x80010110) == 4);
+
+    bitset_c<uint32_t> wide(0, 17, 31);
+    hard_assert(wide.count() == 3);
+    int bits[3];
+    int count = 0;
+    for (const int bit : wide) {
+        hard_assert(count < 3);
+        bits[count++] = bit;
+    }
+    hard_assert(count == 3 && bits[0] == 0 && bits[1] == 17 && bits[2] == 31);
+
+    // Sign extension must not produce bits past the end
+    bitset_c<int8_t> narrow(7);
+    hard_assert(narrow.count() == 1);
+    count = 0;
+    for (const int bit : narrow) {
+        hard_assert(bit == 7);
+        ++count;
+    }
+    hard_assert(count == 1);
+}
+
+__neverinline static void __test_bitset_array() {
+    bitset_array_c<300> bits;
+    hard_assert(bitset_array_c<300>::word_count == 10);
+    hard_assert(bits.none() && bits.count() == 0);
+    hard_assert(bits.find_first() == 300 && "Empty set should find end");
+    hard_assert(bits.begin() == bits.end());
+
+    const int set_bits[] = { 0, 31, 32, 95, 160, 299 };
+    for (const int bit : set_bits) {
+        bits.set(bit);
+    }
+    hard_assert(bits.any() && bits.count() == 6);
+    hard_assert(bits[31] && bits.test(32) && !bits[33]);
+    hard_assert(bits.find_first() == 0);
+    hard_assert(bits.find_next(0) == 31);
+    hard_assert(bits.find_next(32) == 95);
+    hard_assert(bits.find_next(160) == 299);
+    hard_assert(bits.find_next(299) == 300);
+    int idx = 0;
+    for (const int bit : bits) {
+        hard_assert(idx < 6 && bit == set_bits[idx] && "Bits should iterate in order");
+        ++idx;
+    }
+    hard_assert(idx == 6);
+
+    bits.reset(0);
+    bits.set(95, false);
+    hard_assert(bits.find_first() == 31 && bits.count() == 4);
+
+    bitset_array_c<300> other;
+    other.set(31);
+    other.set(200);
+    bitset_array_c<300> both = bits;
+    both &= other;
+    hard_assert(both.count() == 1 && both[31]);
+    both += other;
+    hard_assert(both.count() == 2 && both[200]);
+    both -= other;
+    hard_assert(both.none());
+    bits.clear();
+    hard_assert(bits == both);
+}
+
 void test_bitset() {
     printf("== Start: test_bitset\n\r");
     __test_bitset_basic();
     __test_bitset_operators();
     __test_bitset_iterator();
+    __test_bitset_scan();
+    __test_bitset_array();
     printf("test_bitset pass.\n\r");
 }
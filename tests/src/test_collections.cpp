@@ -10,7 +10,12 @@
 #include "core/array.hpp"
 #include "core/vector.hpp"
 #include "core/list.hpp"
+#include "core/intrusive_list.hpp"
 #include "core/map.hpp"
+#include "core/hash_map.hpp"
+#include "core/memory.hpp"
+#include "core/span.hpp"
+#include "core/ring_buffer.hpp"
 
 __neverinline void test_array_and_vector() {
     printf("== Start: test_array_and_vector\n\r");
@@ -186,6 +191,122 @@ __neverinline void test_dynamic_vector() {
     printf("test_dynamic_vector pass.\n\r");
 }
 
+__neverinline void test_small_vector() {
+    printf("== Start: test_small_vector\n\r");
+    small_vector_c<non_trivial_s, 4> vec;
+    hard_assert(vec.size() == 0 && "Initial size should be 0");
+    hard_assert(vec.capacity() == 4 && "Initial capacity should be inline count");
+    const auto* inline_data = vec.data();
+
+    // Stays inline until full
+    for (int i = 0; i < 4; ++i) {
+        vec.emplace_back(i);
+    }
+    hard_assert(vec.capacity() == 4 && "Should not spill when exactly full");
+    hard_assert(vec.data() == inline_data && "Should use inline storage");
+
+    // Spills to heap, and elements are moved not copied
+    vec.emplace_back(4);
+    hard_assert(vec.size() == 5);
+    hard_assert(vec.capacity() >= 5 && "Capacity should grow on spill");
+    hard_assert(vec.data() != inline_data && "Should use heap storage after spill");
+    for (int i = 0; i < 5; ++i) {
+        hard_assert(vec[i].value == i && "Elements should be preserved on spill");
+        hard_assert(vec[i].generation == 0 && "Elements should be moved on spill");
+    }
+
+    // Move steals heap storage, and resets source to inline storage
+    small_vector_c<non_trivial_s, 4> heap_moved(move(vec));
+    hard_assert(heap_moved.size() == 5);
+    hard_assert(heap_moved[4].value == 4);
+    hard_assert(vec.size() == 0 && "Moved from should be empty");
+    hard_assert(vec.capacity() == 4 && "Moved from should be inline");
+    hard_assert(vec.data() == inline_data);
+
+    // Move of inline storage moves elements one by one
+    vec.emplace_back(10);
+    vec.emplace_back(11);
+    small_vector_c<non_trivial_s, 4> inline_moved(move(vec));
+    hard_assert(inline_moved.size() == 2);
+    hard_assert(inline_moved.capacity() == 4);
+    hard_assert(inline_moved[0].value == 10 && inline_moved[1].value == 11);
+    hard_assert(inline_moved[0].generation == 0 && "Inline elements should be moved");
+    hard_assert(vec.size() == 0);
+
+    // Move assign from heap over inline, and inline over heap
+    inline_moved = move(heap_moved);
+    hard_assert(inline_moved.size() == 5 && inline_moved.capacity() >= 5);
+    hard_assert(heap_moved.size() == 0 && heap_moved.capacity() == 4);
+    heap_moved.emplace_back(20);
+    inline_moved = move(heap_moved);
+    hard_assert(inline_moved.size() == 1 && inline_moved.capacity() == 4);
+    hard_assert(inline_moved[0].value == 20);
+
+    // Copy, insert and erase works across inline and heap storage
+    small_vector_c<int, 2> ints = { 1, 3 };
+    ints.insert(1, 2);
+    ints.insert(ints.end(), 4);
+    small_vector_c<int, 2> copied(ints);
+    hard_assert(copied.size() == 4);
+    for (int i = 0; i < 4; ++i) {
+        hard_assert(copied[i] == i + 1);
+    }
+    copied.erase(0);
+    hard_assert(copied.size() == 3 && copied.front() == 2 && copied.back() == 4);
+    ints.reserve(32);
+    hard_assert(ints.capacity() >= 32 && ints.size() == 4);
+
+    printf("test_small_vector pass.\n\r");
+}
+
+__neverinline void test_relocatable_vector() {
+    printf("== Start: test_relocatable_vector\n\r");
+    static_assert(is_trivially_relocatable<unique_ptr_c<int>>::value);
+    static_assert(is_trivially_relocatable<pair_c<int, unique_ptr_c<int>>>::value);
+    static_assert(is_trivially_relocatable<pair_c<int, shared_ptr_c<int>>>::value);
+    static_assert(!is_trivially_relocatable<non_trivial_s>::value);
+    static_assert(!is_trivially_relocatable<pair_c<int, non_trivial_s>>::value);
+
+    // Growth, insert and erase relocates owners without double deletes
+    vector_c<unique_ptr_c<non_trivial_s>, 0> vec;
+    for (int i = 0; i < 20; ++i) {
+        vec.emplace_back(new non_trivial_s(i * 2));
+    }
+    vec.emplace(vec.begin(), new non_trivial_s(-1));
+    vec.emplace(5, new non_trivial_s(7));
+    hard_assert(vec.size() == 22);
+    hard_assert(vec[0]->value == -1 && vec[1]->value == 0);
+    hard_assert(vec[5]->value == 7 && vec[6]->value == 8);
+    non_trivial_s::s_destructors = 0;
+    vec.erase(0);
+    hard_assert(non_trivial_s::s_destructors == 1 && "Only erased element destroyed");
+    hard_assert(vec.size() == 21 && vec[0]->value == 0 && vec[4]->value == 7);
+    vec.clear();
+    hard_assert(non_trivial_s::s_destructors == 22 && "All elements destroyed once");
+
+    // Inserting an element of the same vector
+    vector_c<int, 8> ints = { 1, 2, 3 };
+    ints.insert(ints.begin(), ints[1]);
+    ints.insert(ints.end(), ints[0]);
+    hard_assert(ints.size() == 5);
+    hard_assert(ints[0] == 2 && ints[1] == 1 && ints[3] == 3 && ints[4] == 2);
+
+    // Map insert and erase in the middle
+    map_c<int, shared_ptr_c<non_trivial_s>, 0> map;
+    for (int i = 0; i < 10; ++i) {
+        map.emplace(move(i * 10), shared_ptr_c<non_trivial_s>(new non_trivial_s(i)));
+    }
+    map.emplace(move(15), shared_ptr_c<non_trivial_s>(new non_trivial_s(100)));
+    hard_assert(map.size() == 11);
+    hard_assert(map[15]->value == 100 && map[20]->value == 2);
+    non_trivial_s::s_destructors = 0;
+    map.erase(10);
+    hard_assert(non_trivial_s::s_destructors == 1);
+    hard_assert(map.size() == 10 && map[15]->value == 100 && map[0]->value == 0);
+
+    printf("test_relocatable_vector pass.\n\r");
+}
+
 struct test_list_state_s {
     list_c<non_trivial_s, 0> list;
     int first_gen;
@@ -506,6 +627,157 @@ void test_list() {
     printf("test_list pass.\n\r");
 }
 
+struct test_intrusive_node_s : public intrusive_list_node_s<test_intrusive_node_s> {
+    test_intrusive_node_s(int v) : value(v) {}
+    int value;
+};
+
+__neverinline void test_intrusive_list() {
+    printf("== Start: test_intrusive_list\n\r");
+    test_intrusive_node_s nodes[] = { 0, 1, 2, 3, 4, 5 };
+    intrusive_list_c<test_intrusive_node_s> list;
+    hard_assert(list.empty() && list.size() == 0);
+
+    list.push_back(nodes[1]);
+    list.push_back(nodes[2]);
+    list.push_front(nodes[0]);
+    list.insert(list.end(), nodes[3]);
+    hard_assert(list.size() == 4);
+    int expected = 0;
+    for (const auto& node : list) {
+        hard_assert(node.value == expected++ && "Elements should be in insertion order");
+    }
+    hard_assert(list.front().value == 0 && list.back().value == 3);
+
+    // Unlink from middle, front and back
+    hard_assert(list.erase(nodes[2])->value == 3);
+    hard_assert(list.size() == 3);
+    hard_assert(nodes[2].next == nullptr && nodes[2].prev == nullptr && "Unlinked node should be reset");
+    list.pop_front();
+    list.pop_back();
+    hard_assert(list.size() == 1 && list.front().value == 1 && list.back().value == 1);
+    hard_assert(list.erase(nodes[1]) == list.end());
+    hard_assert(list.empty());
+
+    // Copies are never linked
+    list.push_back(nodes[0]);
+    test_intrusive_node_s copy = nodes[0];
+    hard_assert(copy.next == nullptr && copy.prev == nullptr);
+    list.push_back(copy);
+    hard_assert(list.size() == 2);
+
+    // Splice single element, and whole list
+    intrusive_list_c<test_intrusive_node_s> other;
+    other.push_back(nodes[4]);
+    other.push_back(nodes[5]);
+    list.splice(list.begin(), other, nodes[5]);
+    hard_assert(other.size() == 1 && list.size() == 3);
+    hard_assert(list.front().value == 5);
+    list.splice(list.end(), other);
+    hard_assert(other.empty() && other.size() == 0);
+    hard_assert(list.size() == 4 && list.back().value == 4);
+    other.splice(other.begin(), list);
+    hard_assert(list.empty() && other.size() == 4);
+    const int expected_values[] = { 5, 0, 0, 4 };
+    int i = 0;
+    for (const auto& node : other) {
+        hard_assert(node.value == expected_values[i++]);
+    }
+    other.clear();
+    hard_assert(other.empty() && nodes[4].prev == nullptr);
+
+    printf("test_intrusive_list pass.\n\r");
+}
+
+__neverinline void test_span2d() {
+    printf("== Start: test_span2d\n\r");
+    int16_t grid[6 * 4];
+    for (int i = 0; i < 6 * 4; ++i) {
+        grid[i] = i;
+    }
+    span2d_c<int16_t> span(grid, size_s(6, 4));
+    hard_assert(span.width() == 6 && span.height() == 4 && span.stride() == 6);
+    hard_assert((span[2, 1] == 8));
+    hard_assert(span[point_s(5, 3)] == 23);
+    hard_assert(span[3].size() == 6 && span[3][0] == 18);
+
+    int rows = 0;
+    int sum = 0;
+    for (const auto row : span) {
+        for (const auto value : row) {
+            sum += value;
+        }
+        ++rows;
+    }
+    hard_assert(rows == 4 && sum == (23 * 24) / 2);
+
+    // Sub span shares stride, and writes through to the grid
+    auto sub = span.subspan(rect_s(1, 1, 3, 2));
+    hard_assert(sub.width() == 3 && sub.height() == 2 && sub.stride() == 6);
+    hard_assert((sub[0, 0] == 7 && sub[2, 1] == 15));
+    for (auto row : sub) {
+        for (auto& value : row) {
+            value = -1;
+        }
+    }
+    hard_assert(grid[6] == 6 && grid[7] == -1 && grid[9] == -1 && grid[10] == 10);
+    hard_assert(grid[13] == -1 && grid[15] == -1 && grid[19] == 19);
+    const auto& csub = sub;
+    hard_assert(csub[1][2] == -1);
+
+    // Empty span has no rows
+    span2d_c<int16_t> empty;
+    hard_assert(empty.begin() == empty.end());
+
+    printf("test_span2d pass.\n\r");
+}
+
+__neverinline void test_ring_buffer() {
+    printf("== Start: test_ring_buffer\n\r");
+    ring_buffer_c<int, 4> ring;
+    hard_assert(ring.empty() && !ring.full() && ring.size() == 0);
+    hard_assert(ring.front() == nullptr && !ring.pop());
+
+    // All slots are usable
+    for (int i = 0; i < 4; ++i) {
+        hard_assert(ring.push(i));
+    }
+    hard_assert(ring.full() && ring.size() == 4);
+    hard_assert(!ring.push(4) && "Push to full ring should fail");
+
+    // Values come out in order across many wraps
+    int next_in = 4;
+    int next_out = 0;
+    for (int i = 0; i < 100; ++i) {
+        int value = -1;
+        hard_assert(ring.pop(value) && value == next_out++);
+        hard_assert(ring.push(next_in++));
+        if ((i & 7) == 0) {
+            hard_assert(*ring.front() == next_out);
+            hard_assert(ring.pop() && ring.emplace(next_in));
+            ++next_out; ++next_in;
+        }
+    }
+    hard_assert(ring.size() == 4);
+    ring.clear();
+    hard_assert(ring.empty());
+
+    // Values are constructed on push, and destroyed on pop or clear
+    {
+        ring_buffer_c<non_trivial_s, 8> objects;
+        non_trivial_s::s_destructors = 0;
+        objects.emplace(1);
+        objects.emplace(2);
+        objects.emplace(3);
+        non_trivial_s out;
+        hard_assert(objects.pop(out) && out.value == 1 && out.generation == 0);
+        hard_assert(non_trivial_s::s_destructors == 1 && "Popped slot destroyed");
+    }
+    hard_assert(non_trivial_s::s_destructors == 4 && "Remaining values destroyed");
+
+    printf("test_ring_buffer pass.\n\r");
+}
+
 void test_map() {
     printf("== Start: test_map\n\r");
     map_c<int, int, 6> map1({{6,0},{2,2}, {4,1}});
@@ -646,3 +918,93 @@ void test_map() {
 
     printf("test_map pass.\n\r");
 }
+
+__neverinline void test_hash_map() {
+    printf("== Start: test_hash_map\n\r");
+    // Test static storage with initializer list
+    {
+        hash_map_c<int, int, 8> map1({{6,0}, {2,2}, {4,1}});
+        hard_assert(map1.size() == 3);
+        hard_assert(map1.capacity() == 8);
+        hard_assert(map1[2] == 2);
+        hard_assert(map1[4] == 1);
+        hard_assert(map1[6] == 0);
+        map1.insert({2, 10});
+        hard_assert(map1.size() == 3 && "Insert of existing key should replace");
+        hard_assert(map1[2] == 10);
+        hard_assert(map1.find(5) == map1.end() && "Should not find missing key");
+        hard_assert(map1.contains(6) && !map1.contains(7));
+        hard_assert(map1.erase(4) && "Should erase existing key");
+        hard_assert(!map1.erase(4) && "Should not erase missing key");
+        hard_assert(map1.size() == 2);
+        int sum = 0;
+        for (const auto& pair : map1) {
+            sum += pair.first;
+        }
+        hard_assert(sum == 8 && "Iteration should visit all keys");
+        for (int i = 10; i < 15; ++i) {
+            map1.insert({i, i});
+        }
+        hard_assert(map1.size() == 7);
+        map1.insert({10, 20});
+        hard_assert(map1.size() == 7 && map1[10] == 20 && "Replacing in a full map should not need a slot");
+    }
+
+    // Test colliding keys survive erase of earlier probe entries
+    {
+        hash_map_c<int, int, 16> map2;
+        // Keys 1, 17, 33 all hash to the same home slot
+        map2.insert({1, 1});
+        map2.insert({17, 17});
+        map2.insert({33, 33});
+        map2.insert({2, 2});
+        hard_assert(map2.erase(1));
+        hard_assert(map2.find(17) != map2.end() && map2[17] == 17 && "Collided key must be found after erase");
+        hard_assert(map2.find(33) != map2.end() && map2[33] == 33 && "Collided key must be found after erase");
+        hard_assert(map2[2] == 2);
+        hard_assert(map2.erase(17) && map2.erase(33) && map2.erase(2));
+        hard_assert(map2.size() == 0 && map2.begin() == map2.end());
+    }
+
+    // Test dynamic storage grows and rehashes
+    {
+        hash_map_c<uint16_t, int, 0> map3;
+        hard_assert(map3.capacity() == 0 && map3.find(1) == map3.end());
+        for (int i = 0; i < 200; ++i) {
+            map3.emplace((uint16_t)(i * 7), i);
+        }
+        hard_assert(map3.size() == 200);
+        hard_assert(map3.capacity() >= 256 && (map3.capacity() & (map3.capacity() - 1)) == 0 && "Capacity should be a power of two");
+        for (int i = 0; i < 200; i += 2) {
+            hard_assert(map3.erase((uint16_t)(i * 7)));
+        }
+        for (int i = 0; i < 200; ++i) {
+            auto it = map3.find((uint16_t)(i * 7));
+            if (i & 1) {
+                hard_assert(it != map3.end() && it->second == i && "Odd keys should remain");
+            } else {
+                hard_assert(it == map3.end() && "Even keys should be erased");
+            }
+        }
+        hash_map_c<uint16_t, int, 0> map4(move(map3));
+        hard_assert(map4.size() == 100 && map3.size() == 0 && "Move should transfer ownership");
+    }
+
+    // Test non-trivial values and string keys
+    {
+        non_trivial_s::s_destructors = 0;
+        {
+            hash_map_c<const char*, non_trivial_s, 0> map5;
+            char name[8] = "tileset";
+            map5.emplace("image", non_trivial_s(1));
+            map5.emplace("tileset", non_trivial_s(2));
+            map5.emplace("font", non_trivial_s(3));
+            hard_assert(map5.find(name) != map5.end() && map5[name].value == 2 && "String keys should compare content");
+            hard_assert(map5.erase("image"));
+            hard_assert(map5.size() == 2);
+        }
+        hard_assert(non_trivial_s::s_destructors >= 3 && "All values must be destroyed");
+    }
+
+    printf("test_hash_map pass.\n\r");
+}
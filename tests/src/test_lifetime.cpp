@@ -10,6 +10,7 @@
 #include "core/array.hpp"
 #include "core/vector.hpp"
 #include "core/list.hpp"
+#include "core/inplace_function.hpp"
 
 struct lifetime_test_state_s {
     // Empty for now, allows future state sharing if needed
@@ -452,6 +453,55 @@ __neverinline void test_lifetime_list_splice(lifetime_test_state_s& state) {
     printf("  test_lifetime_list_splice pass.\n\r");
 }
 
+static int test_add_one(int v) {
+    return v + 1;
+}
+
+__neverinline static void test_lifetime_inplace_function() {
+    printf("  test_lifetime_inplace_function\n\r");
+    using func_t = inplace_function_c<int(int)>;
+    func_t empty;
+    hard_assert(!empty && "Default constructed should be empty");
+    func_t null_func = nullptr;
+    hard_assert(!null_func && "nullptr constructed should be empty");
+    int (*null_ptr)(int) = nullptr;
+    func_t null_ptr_func = null_ptr;
+    hard_assert(!null_ptr_func && "Null function pointer should be empty");
+
+    func_t ptr_func = test_add_one;
+    hard_assert(ptr_func && ptr_func(1) == 2);
+
+    // Captures are owned, and outlive the scope they were captured in
+    func_t captured;
+    {
+        int base = 10;
+        captured = [base](int v) { return base + v; };
+    }
+    hard_assert(captured(5) == 15);
+    func_t copied = captured;
+    hard_assert(copied(1) == 11 && captured(1) == 11);
+
+    // Non-trivial captures are copied, moved and destroyed exactly once each
+    non_trivial_s::s_destructors = 0;
+    {
+        non_trivial_s value(7);
+        inplace_function_c<int(int), 32> owner = [value](int v) { return value.value * v; };
+        hard_assert(owner(3) == 21);
+        const int destructors = non_trivial_s::s_destructors;
+        inplace_function_c<int(int), 32> moved = move(owner);
+        hard_assert(moved(2) == 14);
+        inplace_function_c<int(int), 32> copy = moved;
+        hard_assert(copy(1) == 7);
+        hard_assert(non_trivial_s::s_destructors == destructors && "No destruction on copy or move");
+        copy = nullptr;
+        hard_assert(!copy && non_trivial_s::s_destructors == destructors + 1 && "Reset destroys capture");
+    }
+    // Captured value, moved from capture in owner, and the capture in moved
+    hard_assert(non_trivial_s::s_destructors >= 4 && "All captures destroyed");
+
+    printf("  test_lifetime_inplace_function pass.\n\r");
+}
+
 void test_lifetime() {
     printf("== Start: test_lifetime\n\r");
     lifetime_test_state_s state;
@@ -463,5 +513,6 @@ void test_lifetime() {
     test_lifetime_list_insert(state);
     test_lifetime_list_remove(state);
     test_lifetime_list_splice(state);
+    test_lifetime_inplace_function();
     printf("test_lifetime pass.\n\r");
 }
@@ -8,6 +8,8 @@
 #include "shared.hpp"
 
 #include "core/math.hpp"
+#include "core/geometry.hpp"
+#include "core/random.hpp"
 
 __neverinline void test_math() {
     printf("== Start: test_math\n\r");
@@ -66,6 +68,22 @@ __neverinline void test_math() {
     hard_assert(ceil(numbers::e) == 3);
     hard_assert(round(numbers::e) == 3);
 
+    // 20:12 fix32_t, for world coordinates beyond fix16_t range
+    const fix32_t far_x(100000);
+    hard_assert(static_cast<int32_t>(far_x) == 100000);
+    hard_assert(fix32_t(fix16_t(1.5f)) == fix32_t(1.5f));
+    hard_assert(fix16_t(fix32_t(-2.25f)) == fix16_t(-2.25f));
+    hard_assert(fix32_t(1000) * fix32_t(300) == 300000);
+    hard_assert(fix32_t(3000.5f) * fix32_t(-0.5f) == fix32_t(-1500.25f));
+    hard_assert(fix32_t(300000) / fix32_t(1000) == 300);
+    hard_assert(fix32_t(-7.5f) / fix32_t(2.5f) == -3);
+    hard_assert(fix32_t(100000) / fix32_t(-0.25f) == -400000);
+
+    const frect32_s far_rect(fix32_t(4000), fix32_t(10), fix32_t(16), fix32_t(16));
+    hard_assert(far_rect.intersects(frect32_s(fix32_t(4015), fix32_t(25), fix32_t(16), fix32_t(16))));
+    hard_assert(!far_rect.intersects(frect32_s(fix32_t(4016), fix32_t(10), fix32_t(16), fix32_t(16))));
+    hard_assert(static_cast<rect_s>(far_rect).origin.x == 4000);
+    hard_assert(static_cast<frect32_s>(frect_s(1, 2, 3, 4)).size.height == 4);
 
     printf("test_math pass.\n\r");
 }
@@ -110,3 +128,131 @@ __neverinline void test_math_functions() {
 
     printf("test_math_functions pass.\n\r");
 }
+
+#ifndef __M68000__
+// Returns the distance in LSBs from the exact result, rounded to nearest and saturated.
+static int lsb_error(fix16_t value, double exact) {
+    double raw = __builtin_floor(exact * 16 + 0.5);
+    if (raw > INT16_MAX) raw = INT16_MAX;
+    if (raw < INT16_MIN) raw = INT16_MIN;
+    return ABS(value.raw - static_cast<int32_t>(raw));
+}
+#endif
+
+__neverinline void test_math_tables() {
+    printf("== Start: test_math_tables\n\r");
+
+    hard_assert(toybox::sqrt(fix16_t(16)) == 4);
+    hard_assert(toybox::sqrt(fix16_t(0)) == 0);
+    hard_assert(toybox::rsqrt(fix16_t(4)) == fix16_t(0.5f));
+    hard_assert(toybox::reciprocal(fix16_t(4)) == fix16_t(0.25f));
+    hard_assert(toybox::reciprocal(fix16_t(-2)) == fix16_t(-0.5f));
+    hard_assert(toybox::reciprocal(fix16_t(100)) == 0);
+    hard_assert(toybox::exp2(fix16_t(3)) == 8);
+    hard_assert(toybox::exp2(fix16_t(-1)) == fix16_t(0.5f));
+    hard_assert(toybox::exp2(fix16_t(12)).raw == INT16_MAX);
+    hard_assert(toybox::log2(fix16_t(8)) == 3);
+    hard_assert(toybox::log2(fix16_t(0.5f)) == -1);
+    hard_assert(toybox::atan2(fix16_t(0), fix16_t(0)) == 0);
+    hard_assert(toybox::atan2(fix16_t(0), fix16_t(1)) == 0);
+    hard_assert(toybox::atan2(fix16_t(1), fix16_t(0)) == numbers::pi_2);
+    hard_assert(toybox::atan2(fix16_t(0), fix16_t(-1)) == numbers::pi);
+    hard_assert(toybox::atan2(fix16_t(-1), fix16_t(0)) == -numbers::pi_2);
+
+#ifndef __M68000__
+    // Exhaustive over the full domain against double
+    for (int32_t raw = INT16_MIN; raw <= INT16_MAX; ++raw) {
+        const fix16_t x(static_cast<int16_t>(raw), true);
+        const double d = raw / 16.0;
+        hard_assert(lsb_error(toybox::exp2(x), __builtin_exp2(d)) <= 1 && "exp2 error too large");
+        if (raw != 0) {
+            hard_assert(lsb_error(toybox::reciprocal(x), 1 / d) <= 1 && "reciprocal error too large");
+        }
+        if (raw > 0) {
+            hard_assert(lsb_error(toybox::sqrt(x), __builtin_sqrt(d)) <= 1 && "sqrt error too large");
+            hard_assert(lsb_error(toybox::rsqrt(x), 1 / __builtin_sqrt(d)) <= 1 && "rsqrt error too large");
+            hard_assert(lsb_error(toybox::log2(x), __builtin_log2(d)) <= 1 && "log2 error too large");
+        }
+    }
+    for (int32_t y = INT16_MIN; y <= INT16_MAX; y += 61) {
+        for (int32_t x = INT16_MIN; x <= INT16_MAX; x += 67) {
+            const fix16_t a = toybox::atan2(fix16_t(static_cast<int16_t>(y), true), fix16_t(static_cast<int16_t>(x), true));
+            hard_assert(lsb_error(a, __builtin_atan2(y, x)) <= 1 && "atan2 error too large");
+        }
+    }
+    for (int y = -64; y <= 64; ++y) {
+        for (int x = -64; x <= 64; ++x) {
+            const fix16_t a = toybox::atan2(fix16_t(static_cast<int16_t>(y), true), fix16_t(static_cast<int16_t>(x), true));
+            hard_assert(lsb_error(a, __builtin_atan2(y, x)) <= 1 && "atan2 error too large");
+        }
+    }
+#endif
+
+    printf("test_math_tables pass.\n\r");
+}
+
+__neverinline void test_rand_stream() {
+    printf("== Start: test_rand_stream\n\r");
+
+    // Reference PCG step, using plain 32 bit multiplication
+    uint32_t ref_state = 0;
+    const uint32_t ref_inc = (7u << 1) | 1;
+    const auto ref_step = [&] { ref_state = ref_state * 747796405u + ref_inc; };
+    ref_step();
+    ref_state += 1234;
+    ref_step();
+    rand_stream_c stream(1234, 7);
+    for (int i = 0; i < 100; ++i) {
+        const uint32_t old = ref_state;
+        ref_step();
+        const uint16_t xorshifted = static_cast<uint16_t>(((old >> 10) ^ old) >> 12);
+        const int rot = old >> 28;
+        const uint16_t expected = static_cast<uint16_t>((xorshifted >> rot) | (xorshifted << ((16 - rot) & 15)));
+        hard_assert(stream.next() == expected && "Stream must match reference PCG");
+    }
+
+    // Same seed and stream replays, other streams do not
+    rand_stream_c a(42, 1), b(42, 1), c(42, 2);
+    int same = 0;
+    for (int i = 0; i < 64; ++i) {
+        const uint16_t va = a.next();
+        hard_assert(va == b.next() && "Same seed and stream must replay");
+        same += va == c.next();
+    }
+    hard_assert(same < 4 && "Streams should be independent");
+
+    // Jump ahead and back
+    rand_stream_c walk(99, 3), jump(99, 3);
+    const uint32_t start = jump.state();
+    for (int i = 0; i < 1000; ++i) {
+        walk.next();
+    }
+    jump.jump(1000);
+    hard_assert(walk.state() == jump.state() && "Jump must match iterating");
+    hard_assert(walk.next() == jump.next());
+    jump.jump(static_cast<uint32_t>(-1001));
+    hard_assert(jump.state() == start && "Negative jump must rewind");
+
+    // Bounded values
+    int buckets[6] = { 0 };
+    for (int i = 0; i < 6000; ++i) {
+        const uint16_t v = walk.next(6);
+        hard_assert(v < 6);
+        buckets[v]++;
+    }
+    for (int i = 0; i < 6; ++i) {
+        hard_assert(buckets[i] > 800 && buckets[i] < 1200 && "Bounded values should be uniform");
+    }
+    bool seen_min = false, seen_max = false;
+    for (int i = 0; i < 1000; ++i) {
+        const int16_t v = walk.range(-3, 3);
+        hard_assert(v >= -3 && v <= 3);
+        seen_min |= v == -3;
+        seen_max |= v == 3;
+    }
+    hard_assert(seen_min && seen_max && "Range must be inclusive");
+    walk.range(INT16_MIN, INT16_MAX);
+    hard_assert(walk.next(1) == 0);
+
+    printf("test_rand_stream pass.\n\r");
+}
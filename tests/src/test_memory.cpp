@@ -7,7 +7,10 @@
 
 #include "shared.hpp"
 
+#include "core/frame_arena.hpp"
 #include "core/memory.hpp"
+#include "core/slab_allocator.hpp"
+#include "core/memory_telemetry.hpp"
 
 class non_trivial_subclass_s : public non_trivial_s {
 public:
@@ -157,3 +160,238 @@ __neverinline void test_shared_ptr() {
 
     printf("== End: test_shared_ptr\n\r");
 }
+
+__neverinline void test_frame_arena() {
+    printf("== Start: test_frame_arena\n\r");
+
+    frame_arena_c::reset();
+    hard_assert(frame_arena_c::used() == 0 && "Reset arena should be empty");
+
+    // Test allocations are aligned and sequential
+    {
+        auto a = frame_arena_c::allocate(3);
+        auto b = frame_arena_c::allocate(5);
+        hard_assert(frame_arena_c::owns(a) && frame_arena_c::owns(b) && "Arena should own allocations");
+        hard_assert(((uintptr_t)b % frame_arena_c::alignment) == 0 && "Allocation should be aligned");
+        hard_assert((uint8_t*)b - (uint8_t*)a == frame_arena_c::alignment && "Allocations should be sequential");
+        frame_arena_c::deallocate(a);
+        frame_arena_c::deallocate(b);
+        hard_assert(frame_arena_c::used() == frame_arena_c::alignment * 2 && "Deallocate should not release");
+    }
+
+    // Test make and make_array
+    {
+        struct point_s { int16_t x, y; };
+        auto point = frame_arena_c::make<point_s>(3, 7);
+        hard_assert(point->x == 3 && point->y == 7 && "Made object should be constructed");
+        auto values = frame_arena_c::make_array<int16_t>(10);
+        for (int i = 0; i < 10; ++i) {
+            hard_assert(values[i] == 0 && "Made array should be value initialized");
+        }
+        int local = 0;
+        hard_assert(!frame_arena_c::owns(&local) && "Arena should not own stack memory");
+    }
+
+    // Test reset reuses memory
+    {
+        auto before = frame_arena_c::allocate(16);
+        frame_arena_c::reset();
+        hard_assert(frame_arena_c::used() == 0 && "Reset arena should be empty");
+        auto first = frame_arena_c::allocate(16);
+        auto again = frame_arena_c::allocate(16);
+        hard_assert(first != again && "Allocations should be distinct");
+#ifndef __M68000__
+        hard_assert(frame_arena_c::peak_used() >= frame_arena_c::used() && "Peak should track usage");
+#endif
+        (void)before;
+    }
+    frame_arena_c::reset();
+
+    printf("test_frame_arena pass.\n\r");
+}
+
+__neverinline void test_slab_allocator() {
+    printf("== Start: test_slab_allocator\n\r");
+
+    // Test size class mapping
+    static_assert(slab_allocator_c::size_class(0) == 0);
+    static_assert(slab_allocator_c::size_class(8) == 0);
+    static_assert(slab_allocator_c::size_class(9) == 1);
+    static_assert(slab_allocator_c::size_class(24) == 2);
+    static_assert(slab_allocator_c::size_class(33) == 4);
+    static_assert(slab_allocator_c::size_class(128) == 5);
+    static_assert(slab_allocator_c::size_class(129) == -1);
+
+    // Test small allocations are owned and reused
+    {
+        void* a = slab_allocator_c::allocate(20);
+        void* b = slab_allocator_c::allocate(20);
+        hard_assert(a != b && "Allocations should be distinct");
+        hard_assert(slab_allocator_c::owns(a) && slab_allocator_c::owns(b) && "Small allocations should be owned");
+        slab_allocator_c::deallocate(b);
+        void* c = slab_allocator_c::allocate(24);
+        hard_assert(c == b && "Freed block should be reused by same size class");
+        slab_allocator_c::deallocate(a);
+        slab_allocator_c::deallocate(c);
+    }
+
+    // Test large and foreign allocations pass through
+    {
+        void* large = slab_allocator_c::allocate(256);
+        hard_assert(!slab_allocator_c::owns(large) && "Large allocations should not be owned");
+        slab_allocator_c::deallocate(large);
+        void* foreign = _malloc(16);
+        hard_assert(!slab_allocator_c::owns(foreign) && "Malloc allocations should not be owned");
+        slab_allocator_c::deallocate(foreign);
+        slab_allocator_c::deallocate(nullptr);
+    }
+
+    // Test many allocations spanning several chunks
+    {
+        constexpr int count = slab_allocator_c::chunk_size / 8;
+        static void* s_ptrs[count];
+        for (int i = 0; i < count; ++i) {
+            s_ptrs[i] = slab_allocator_c::allocate(64);
+            memset(s_ptrs[i], i, 64);
+        }
+        for (int i = 0; i < count; ++i) {
+            hard_assert(((uint8_t*)s_ptrs[i])[63] == (uint8_t)i && "Allocations must not overlap");
+            slab_allocator_c::deallocate(s_ptrs[i]);
+        }
+    }
+
+    printf("test_slab_allocator pass.\n\r");
+}
+
+__neverinline void test_pool_allocator() {
+    printf("== Start: test_pool_allocator\n\r");
+
+    // Test fixed-size pool stats
+    {
+        using allocator = pool_allocator_c<int32_t, 4>;
+        void* a = allocator::allocate();
+        void* b = allocator::allocate();
+        allocator::deallocate(a);
+        auto stats = allocator::stats();
+        hard_assert(stats.current_count == 1 && "Fixed pool should have one allocation");
+        hard_assert(stats.peak_count == 2 && "Fixed pool peak should be two");
+        hard_assert(stats.chunk_count == 1 && "Fixed pool should have one chunk");
+        hard_assert(stats.reserved_bytes >= sizeof(int32_t) * 4 && "Fixed pool should reserve all blocks");
+        allocator::deallocate(b);
+    }
+
+    // Test dynamic pool grows, tracks occupancy, and trims
+    {
+        using allocator = pool_allocator_c<int64_t, 0>;
+        static void* s_ptrs[40];
+        for (int i = 0; i < 40; ++i) {
+            s_ptrs[i] = allocator::allocate();
+            *static_cast<int64_t*>(s_ptrs[i]) = i;
+        }
+        auto stats = allocator::stats();
+        hard_assert(stats.current_count == 40 && "Dynamic pool should have 40 allocations");
+        hard_assert(stats.chunk_count == 3 && "Dynamic pool should have grown to 8+16+32 blocks");
+        // Free all from the two first chunks, keep one block in the last
+        for (int i = 0; i < 39; ++i) {
+            hard_assert(*static_cast<int64_t*>(s_ptrs[i]) == i && "Allocations must not overlap");
+            allocator::deallocate(s_ptrs[i]);
+        }
+        allocator::trim();
+        stats = allocator::stats();
+        hard_assert(stats.current_count == 1 && "Dynamic pool should have one allocation");
+        hard_assert(stats.peak_count == 40 && "Dynamic pool peak should be 40");
+        hard_assert(stats.chunk_count == 1 && "Trim should release free chunks");
+        // Reuse remaining chunk before growing
+        void* c = allocator::allocate();
+        hard_assert(allocator::stats().chunk_count == 1 && "Should reuse trimmed pool chunk");
+        allocator::deallocate(c);
+        allocator::deallocate(s_ptrs[39]);
+        allocator::trim();
+        stats = allocator::stats();
+        hard_assert(stats.chunk_count == 0 && stats.reserved_bytes == 0 && "Trim should release all chunks");
+        c = allocator::allocate();
+        hard_assert(allocator::stats().chunk_count == 1 && "Should grow after full trim");
+        allocator::deallocate(c);
+    }
+
+    printf("test_pool_allocator pass.\n\r");
+}
+
+__neverinline void test_memory_telemetry() {
+    printf("== Start: test_memory_telemetry\n\r");
+#if TOYBOX_MEMORY_TELEMETRY
+    // Test global new and delete are tracked
+    {
+        const auto before = memory_telemetry_c::stats();
+        const size_t before_bucket = memory_telemetry_c::histogram(4);
+        // Call operator new directly, new expressions may be elided by the optimizer.
+        auto ptr = ::operator new[](40);
+        auto during = memory_telemetry_c::stats();
+        hard_assert(during.live_bytes == before.live_bytes + 40 && "Live bytes should increase");
+        hard_assert(during.live_count == before.live_count + 1 && "Live count should increase");
+        hard_assert(during.peak_bytes >= during.live_bytes && "Peak should be at least live");
+        hard_assert(memory_telemetry_c::histogram(4) == before_bucket + 1 && "Histogram bucket for 33-64 bytes should increase");
+        ::operator delete[](ptr);
+        auto after = memory_telemetry_c::stats();
+        hard_assert(after.live_bytes == before.live_bytes && "Live bytes should be restored");
+        hard_assert(after.total_count == before.total_count + 1 && "Total count should increase");
+    }
+
+    // Test pool allocations are tracked
+    {
+        using allocator = pool_allocator_c<int32_t, 2>;
+        const auto before = memory_telemetry_c::stats();
+        void* ptr = allocator::allocate();
+        hard_assert(memory_telemetry_c::stats().live_bytes == before.live_bytes + sizeof(int32_t) && "Pool allocation should be tracked");
+        allocator::deallocate(ptr);
+        hard_assert(memory_telemetry_c::stats().live_bytes == before.live_bytes && "Pool deallocation should be tracked");
+    }
+
+    // Test labels attribute allocations
+    {
+        void* ptr = nullptr;
+        memory_telemetry_c::with_label("test:outer", [&] {
+            memory_telemetry_c::with_label("test:inner", [&] {
+                hard_assert(strcmp(memory_telemetry_c::label(), "test:inner") == 0 && "Innermost label should be active");
+                ptr = ::operator new(sizeof(int32_t));
+            });
+            hard_assert(strcmp(memory_telemetry_c::label(), "test:outer") == 0 && "Outer label should be restored");
+        });
+        auto find_label = [](const char* label) {
+            for (int i = 0; i < memory_telemetry_c::label_count(); ++i) {
+                if (strcmp(memory_telemetry_c::label_stats(i).label, label) == 0) {
+                    return memory_telemetry_c::label_stats(i);
+                }
+            }
+            hard_assert(0 && "Label not found");
+            return memory_telemetry_c::label_stats(0);
+        };
+        hard_assert(find_label("test:inner").live_bytes == sizeof(int32_t) && "Inner label should own allocation");
+        hard_assert(find_label("test:outer").live_bytes == 0 && "Outer label should own nothing");
+        ::operator delete(ptr);
+        hard_assert(find_label("test:inner").live_bytes == 0 && "Inner label should be released");
+        hard_assert(find_label("test:inner").peak_bytes == sizeof(int32_t) && "Inner label should keep peak");
+    }
+
+    // Test untracked memory released with delete is ignored
+    {
+        const auto before = memory_telemetry_c::stats();
+        {
+            unique_ptr_c<char> path((char*)_malloc(128));
+        }
+        hard_assert(memory_telemetry_c::stats().live_bytes == before.live_bytes && "Untracked memory should be ignored");
+    }
+
+    // Test per frame counting
+    {
+        memory_telemetry_c::begin_frame();
+        ::operator delete(::operator new(sizeof(int32_t)));
+        ::operator delete(::operator new(sizeof(int32_t)));
+        hard_assert(memory_telemetry_c::stats().frame_count == 2 && "Frame count should be two");
+        hard_assert(memory_telemetry_c::stats().peak_frame_count >= 2 && "Peak frame count should be at least two");
+        memory_telemetry_c::begin_frame();
+        hard_assert(memory_telemetry_c::stats().frame_count == 0 && "Frame count should reset");
+    }
+#endif
+    printf("test_memory_telemetry pass.\n\r");
+}
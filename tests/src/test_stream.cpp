@@ -0,0 +1,599 @@
+//
+//  test_stream.cpp
+//  toybox - tests
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "shared.hpp"
+
+#include "core/stream.hpp"
+#include "core/util_stream.hpp"
+#include "core/iffstream.hpp"
+#include "core/deflate.hpp"
+#include "core/depack.hpp"
+#include "core/pack.hpp"
+#include "runtime/assets.hpp"
+#ifndef __M68000__
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// Forwards to a strstream_c, counting calls to the wrapped stream.
+class counting_stream_c final : public stream_c {
+public:
+    counting_stream_c(size_t len) : _str(len) {}
+    virtual ptrdiff_t tell() const override { return _str.tell(); }
+    virtual ptrdiff_t seek(ptrdiff_t pos, seekdir_e way) override { seeks++; return _str.seek(pos, way); }
+    using stream_c::read;
+    virtual size_t read(uint8_t* buf, size_t count = 1) override { reads++; return _str.read(buf, count); }
+    using stream_c::write;
+    virtual size_t write(const uint8_t* buf, size_t count = 1) override { writes++; return _str.write(buf, count); }
+    uint8_t* data() { return reinterpret_cast<uint8_t*>(_str.str()); }
+    int reads = 0;
+    int writes = 0;
+    int seeks = 0;
+private:
+    strstream_c _str;
+};
+
+__neverinline static void test_bufstream() {
+    auto* counting = new counting_stream_c(4096);
+    shared_ptr_c<stream_c> wrapped(counting);
+    bufstream_c buf(wrapped, 256);
+
+    // Write behind in mixed sizes, including one larger than the buffer
+    uint8_t pattern[3000];
+    for (int i = 0; i < 3000; ++i) {
+        pattern[i] = static_cast<uint8_t>(i * 7);
+    }
+    size_t pos = 0;
+    const size_t sizes[] = { 1, 2, 7, 300, 4, 1 };
+    for (int i = 0; pos < 3000; ++i) {
+        const size_t n = MIN(sizes[i % 6], 3000 - pos);
+        hard_assert(buf.write(pattern + pos, n) == n);
+        pos += n;
+        hard_assert(buf.tell() == static_cast<ptrdiff_t>(pos) && "Tell must include buffered writes");
+    }
+    hard_assert(buf.flush());
+    hard_assert(memcmp(counting->data(), pattern, 3000) == 0 && "Written data must match");
+    hard_assert(counting->writes < 40 && "Small writes must be buffered");
+
+    // Read ahead in small reads
+    hard_assert(buf.seek(0, stream_c::seekdir_e::beg) == 0);
+    counting->reads = 0;
+    for (int i = 0; i < 200; ++i) {
+        uint8_t byte;
+        hard_assert(buf.read(&byte) == 1);
+        hard_assert(byte == pattern[i]);
+    }
+    hard_assert(counting->reads == 1 && "Small reads must be buffered");
+    hard_assert(buf.tell() == 200);
+
+    // Seek within buffer needs no seek of the wrapped stream
+    counting->seeks = 0;
+    hard_assert(buf.seek(-150, stream_c::seekdir_e::cur) == 50);
+    uint16_t word;
+    hard_assert(buf.read(&word) == 2);
+    hard_assert(memcmp(&word, pattern + 50, 2) == 0);
+    hard_assert(counting->seeks == 0 && "Seek within buffer must not seek");
+
+    // Seek outside buffer, and read larger than buffer
+    hard_assert(buf.seek(1000, stream_c::seekdir_e::beg) == 1000);
+    uint8_t large[600];
+    hard_assert(buf.read(large, 600) == 600);
+    hard_assert(memcmp(large, pattern + 1000, 600) == 0 && "Large read must match");
+    hard_assert(buf.tell() == 1600);
+    hard_assert(buf.read(large, 10) == 10);
+    hard_assert(memcmp(large, pattern + 1600, 10) == 0);
+
+    // Write after read lands at the read position
+    hard_assert(buf.seek(10, stream_c::seekdir_e::beg) == 10);
+    hard_assert(buf.read(large, 2) == 2);
+    const uint8_t marks[4] = { 0xaa, 0xbb, 0xcc, 0xdd };
+    hard_assert(buf.write(marks, 4) == 4);
+    hard_assert(buf.tell() == 16);
+    hard_assert(buf.read(large, 2) == 2 && "Read must flush pending writes");
+    hard_assert(memcmp(large, pattern + 16, 2) == 0);
+    hard_assert(memcmp(counting->data() + 12, marks, 4) == 0 && "Write must land at position");
+    hard_assert(memcmp(counting->data() + 10, pattern + 10, 2) == 0);
+
+    // Reads stop at end of data
+    hard_assert(buf.seek(2990, stream_c::seekdir_e::beg) == 2990);
+    hard_assert(buf.read(large, 100) == 10 && "Read must stop at end");
+}
+
+__neverinline static void test_memstream() {
+    uint8_t pattern[256];
+    for (int i = 0; i < 256; ++i) {
+        pattern[i] = static_cast<uint8_t>(i * 3);
+    }
+
+    // Borrowed buffer, views point into the buffer
+    memstream_c mem(pattern, 256);
+    hard_assert(mem.good() && mem.size() == 256);
+    uint8_t bytes[8];
+    hard_assert(mem.read(bytes, 8) == 8);
+    hard_assert(memcmp(bytes, pattern, 8) == 0);
+    const uint8_t* view = mem.view(16);
+    hard_assert(view == pattern + 8 && "View must not copy");
+    hard_assert(mem.tell() == 24);
+    hard_assert(mem.seek(-4, stream_c::seekdir_e::end) == 252);
+    hard_assert(mem.view(8) == nullptr && "View past end must fail");
+    hard_assert(mem.tell() == 252 && "Failed view must not advance");
+    hard_assert(mem.read(bytes, 8) == 4 && "Read must stop at end");
+    hard_assert(mem.seek(257, stream_c::seekdir_e::beg) < 0);
+    hard_assert(mem.seek(256, stream_c::seekdir_e::beg) == 256);
+
+    // Owned buffer, loaded from current position in one read
+    auto* counting = new counting_stream_c(512);
+    shared_ptr_c<stream_c> wrapped(counting);
+    hard_assert(counting->write(pattern, 256) == 256);
+    hard_assert(counting->seek(100, stream_c::seekdir_e::beg) == 100);
+    counting->reads = 0;
+    memstream_c loaded(*counting);
+    hard_assert(loaded.good() && loaded.size() == 156);
+    hard_assert(counting->reads == 1 && "Must load with a single read");
+    hard_assert(memcmp(loaded.data(), pattern + 100, 156) == 0);
+
+    // Prefetched file contents are taken over without reading
+    uint8_t* prefetched = static_cast<uint8_t*>(_malloc(32));
+    memcpy(prefetched, pattern, 32);
+    memstream_c::prefetch("no/such/file.bin", prefetched, 32);
+    memstream_c fetched("no/such/file.bin");
+    hard_assert(fetched.good() && fetched.data() == prefetched && fetched.size() == 32);
+    memstream_c missing("no/such/file.bin");
+    hard_assert(!missing.good() && "Prefetched data must only be taken once");
+    hard_assert(fetched.release() == prefetched && !fetched.good() && "Owned buffer must be handed over");
+    _free(prefetched);
+    uint8_t* copied = mem.release();
+    hard_assert(copied && copied != pattern && memcmp(copied, pattern, 256) == 0 && "Borrowed buffer must be copied");
+    _free(copied);
+
+    // Views forward through decorators and iffstream_c
+    uint8_t chunk[12] = { 'T', 'E', 'S', 'T', 0, 0, 0, 4, 1, 2, 3, 4 };
+    iffstream_c iff(shared_ptr_c<stream_c>(new memstream_c(chunk, 12)));
+    iff_chunk_s test;
+    hard_assert(iff.first(cc4_t("TEST"), test));
+    hard_assert(test.size == 4);
+    hard_assert(iff.view(test.size) == chunk + 8 && "View must forward");
+    bufstream_c buf(wrapped, 64);
+    hard_assert(buf.seek(0, stream_c::seekdir_e::beg) == 0);
+    hard_assert(buf.view(4) == nullptr && "View of empty buffer must fail");
+    hard_assert(buf.read(bytes, 1) == 1);
+    view = buf.view(16);
+    hard_assert(view && memcmp(view, pattern + 1, 16) == 0 && "View must serve buffered data");
+    hard_assert(buf.tell() == 17);
+}
+
+__neverinline static void test_iff_index() {
+    // FORM TEST { AAAA, LIST ITEM { FORM ITEM { BBBB }, FORM ITEM { BBBB } }, CCCC }
+    static constexpr cc4_t TEST("TEST"), ITEM("ITEM"), AAAA("AAAA"), BBBB("BBBB"), CCCC("CCCC");
+    auto* str = new strstream_c(512);
+    shared_ptr_c<stream_c> wrapped(str);
+    {
+        iffstream_c iff(wrapped);
+        iff_chunk_s form, list, item, chunk;
+        const uint8_t data[3] = { 1, 2, 3 };
+        hard_assert(iff.begin(cc4::FORM, form) && iff.write(&TEST));
+        hard_assert(iff.begin(AAAA, chunk) && iff.write(data, 3) && iff.end(chunk));
+        hard_assert(iff.begin(cc4::LIST, list) && iff.write(&ITEM));
+        for (uint8_t i = 0; i < 2; ++i) {
+            hard_assert(iff.begin(cc4::FORM, item) && iff.write(&ITEM));
+            hard_assert(iff.begin(BBBB, chunk) && iff.write(&i) && iff.end(chunk));
+            hard_assert(iff.end(item));
+        }
+        hard_assert(iff.end(list));
+        hard_assert(iff.begin(CCCC, chunk) && iff.write(data, 2) && iff.end(chunk));
+        hard_assert(iff.end(form));
+        const size_t len = iff.tell();
+        iffstream_c file(shared_ptr_c<stream_c>(new memstream_c(reinterpret_cast<uint8_t*>(str->str()), len)));
+
+        iff_index_c index(file);
+        hard_assert(index.good() && index.size() == 8);
+        hard_assert(file.tell() == 0 && "Index must restore position");
+        hard_assert(index.first(cc4::FORM, cc4_t("NOPE")) == nullptr);
+        const auto* root = index.first(cc4::FORM, TEST);
+        hard_assert(root && root == index.begin());
+        hard_assert(root->end == 8 && root->parent == -1);
+
+        // Direct children only, nested chunks are not siblings
+        hard_assert(index.first(*root, BBBB) == nullptr);
+        const auto* a = index.first(*root, cc4::ANY);
+        hard_assert(a && a->id == AAAA && a->size == 3);
+        const auto* l = index.next(*a, cc4::ANY);
+        hard_assert(l && l->id == cc4::LIST && l->subtype == ITEM && l->end == 7);
+        const auto* c = index.next(*l, cc4::ANY);
+        hard_assert(c && c->id == CCCC && c->size == 2);
+        hard_assert(index.next(*c, cc4::ANY) == nullptr);
+        hard_assert(index.next(*a, CCCC) == c);
+
+        // Iterate nested groups, and read data at indexed offsets
+        int count = 0;
+        for (auto f = index.first(*l, cc4::FORM); f; f = index.next(*f, cc4::FORM)) {
+            const auto* b = index.first(*f, BBBB);
+            hard_assert(b && b->parent == (f - index.begin()));
+            uint8_t byte;
+            hard_assert(file.reset(*b) && file.read(&byte) == 1);
+            hard_assert(byte == count && "Must read data of indexed chunk");
+            ++count;
+        }
+        hard_assert(count == 2);
+        hard_assert(index.find(BBBB) == &index[4]);
+        hard_assert(index.find(cc4_t("DDDD")) == nullptr);
+    }
+}
+
+#ifndef __M68000__
+// Compressible test data, with repeats both near and far apart.
+static uint8_t* make_packable(size_t size) {
+    auto* data = static_cast<uint8_t*>(_malloc(size));
+    for (size_t i = 0; i < size; ++i) {
+        data[i] = static_cast<uint8_t>(i < size / 2 ? (i * i) >> 5 : data[i - size / 4 + (i & 3)]);
+    }
+    return data;
+}
+#endif
+
+// Inflates in odd sized reads, to cross block, match and buffer boundaries.
+static size_t inflate_all(const uint8_t* packed, size_t len, uint8_t* buf, size_t max) {
+    memstream_c mem(packed, len);
+    inflate_stream_c inflated(mem);
+    size_t done = 0, step = 1;
+    while (done < max) {
+        const size_t count = inflated.read(buf + done, MIN(step, max - done));
+        if (count == 0) {
+            break;
+        }
+        done += count;
+        step = step * 3 % 31 + 1;
+    }
+    hard_assert(inflated.good());
+    hard_assert(inflated.tell() == static_cast<ptrdiff_t>(done));
+    return done;
+}
+
+__neverinline static void test_inflate() {
+    // Reference streams from zlib, with stored, fixed and dynamic Huffman blocks
+    static const uint8_t stored[] = {
+        0x18, 0x19, 0x01, 0x15, 0x00, 0xea, 0xff, 0x74, 0x6f, 0x79, 0x62, 0x6f, 0x78, 0x20, 0x74, 0x6f,
+        0x79, 0x62, 0x6f, 0x78, 0x20, 0x74, 0x6f, 0x79, 0x62, 0x6f, 0x78, 0x21, 0x5e, 0x57, 0x08, 0x51
+    };
+    static const uint8_t fixed[] = {
+        0x18, 0x19, 0x2b, 0xc9, 0xaf, 0x4c, 0xca, 0xaf, 0x50, 0x28, 0x41, 0xa6, 0x14, 0x01, 0x5e, 0x57,
+        0x08, 0x51
+    };
+    static const uint8_t dynamic[] = {
+        0x18, 0xd3, 0x15, 0x89, 0x31, 0x0a, 0x00, 0x30, 0x10, 0x83, 0xde, 0xea, 0xe0, 0x9a, 0x2e, 0xf9,
+        0x3f, 0xbd, 0x38, 0x08, 0xa2, 0xb1, 0x28, 0xe6, 0x94, 0x50, 0xf5, 0x4d, 0x83, 0xf6, 0xe6, 0x8a,
+        0x0f, 0x4d, 0x32, 0x10, 0x44
+    };
+    static const char toybox[] = "toybox toybox toybox!";
+    static const char letters[] = "enetaeeaeneeannateeeoteeeeeeeatttaeteeea";
+    uint8_t buf[64];
+    hard_assert(inflate_all(stored, sizeof(stored), buf, sizeof(buf)) == 21);
+    hard_assert(memcmp(buf, toybox, 21) == 0);
+    hard_assert(inflate_all(fixed, sizeof(fixed), buf, sizeof(buf)) == 21);
+    hard_assert(memcmp(buf, toybox, 21) == 0);
+    hard_assert(inflate_all(dynamic, sizeof(dynamic), buf, sizeof(buf)) == 40);
+    hard_assert(memcmp(buf, letters, 40) == 0);
+
+    // Corrupt header is an error, not a crash
+    uint8_t corrupt[sizeof(fixed)];
+    memcpy(corrupt, fixed, sizeof(fixed));
+    corrupt[1] ^= 0x01;
+    memstream_c mem(corrupt, sizeof(corrupt));
+    inflate_stream_c inflated(mem);
+    hard_assert(inflated.read(buf, 8) == 0 && !inflated.good());
+
+    // Truncated streams are errors, returning only bytes decoded before the cut,
+    // a cut into the Adler-32 trailer is caught by the checksum
+    for (size_t cut = 1; cut < sizeof(dynamic); cut += 3) {
+        memstream_c cut_mem(dynamic, sizeof(dynamic) - cut);
+        inflate_stream_c cut_inflated(cut_mem);
+        const size_t count = cut_inflated.read(buf, sizeof(buf));
+        hard_assert(!cut_inflated.good());
+        hard_assert(count <= 40 && memcmp(buf, letters, count) == 0);
+        hard_assert(cut_inflated.read(buf, sizeof(buf)) == 0 && !cut_inflated.good());
+    }
+    for (size_t cut = 1; cut <= 4; ++cut) {
+        memstream_c cut_mem(stored, sizeof(stored) - cut);
+        inflate_stream_c cut_inflated(cut_mem);
+        hard_assert(cut_inflated.read(buf, sizeof(buf)) == 21 && !cut_inflated.good());
+    }
+
+    // Skip forward by seeking
+    memstream_c seek_mem(fixed, sizeof(fixed));
+    inflate_stream_c seek_inflated(seek_mem);
+    hard_assert(seek_inflated.seek(7, stream_c::seekdir_e::beg) == 7);
+    hard_assert(seek_inflated.read(buf, 6) == 6 && memcmp(buf, toybox + 7, 6) == 0);
+
+#ifndef __M68000__
+    // Round trip through the host encoder
+    static constexpr size_t size = 12000;
+    auto* plain = make_packable(size);
+    auto* unpacked = static_cast<uint8_t*>(_malloc(size + 1));
+    strstream_c packed(size + 512);
+    const size_t packed_size = deflate(packed, plain, size, 12);
+    hard_assert(packed_size > 0 && packed_size < size);
+    hard_assert(inflate_all(reinterpret_cast<uint8_t*>(packed.str()), packed_size, unpacked, size + 1) == size);
+    hard_assert(memcmp(plain, unpacked, size) == 0);
+    _free(plain);
+    _free(unpacked);
+#endif
+}
+
+__neverinline static void test_depack() {
+    // Seven literals, a 13 byte overlapping match seven back, and a last literal
+    static const uint8_t packed[] = {
+        'T', 'B', 'L', 'Z', 0, 0, 0, 21, 8, 0, 0, 0,
+        0x79, 't', 'o', 'y', 'b', 'o', 'x', ' ', 0, 7,
+        0x10, '!'
+    };
+    static const char* toybox = "toybox toybox toybox!";
+    hard_assert(depack_stream_c::is_packed(packed, sizeof(packed)));
+    hard_assert(!depack_stream_c::is_packed(packed + 1, sizeof(packed) - 1));
+
+    uint8_t buf[32];
+    memstream_c direct_packed(packed, sizeof(packed));
+    depack_stream_c direct(direct_packed);
+    hard_assert(direct.good() && direct.size() == 21);
+    hard_assert(direct.read(buf, sizeof(buf)) == 21 && memcmp(buf, toybox, 21) == 0);
+    hard_assert(direct.read(buf, 1) == 0);
+
+    // Small reads go through the window
+    memstream_c window_packed(packed, sizeof(packed));
+    depack_stream_c window(window_packed);
+    for (int i = 0; i < 21; i += 3) {
+        hard_assert(window.read(buf + i, 3) == 3);
+    }
+    hard_assert(memcmp(buf, toybox, 21) == 0 && window.tell() == 21);
+
+    memstream_c seek_packed(packed, sizeof(packed));
+    depack_stream_c seek_depacked(seek_packed);
+    hard_assert(seek_depacked.seek(9, stream_c::seekdir_e::beg) == 9);
+    hard_assert(seek_depacked.read(buf, 5) == 5 && memcmp(buf, toybox + 9, 5) == 0);
+    hard_assert(seek_depacked.seek(2, stream_c::seekdir_e::beg) == 2 && "Seek backward must restart");
+    hard_assert(seek_depacked.read(buf, 19) == 19 && memcmp(buf, toybox + 2, 19) == 0);
+
+    // Distance before the start is corrupt
+    uint8_t corrupt[sizeof(packed)];
+    memcpy(corrupt, packed, sizeof(packed));
+    corrupt[21] = 8;
+    memstream_c corrupt_packed(corrupt, sizeof(corrupt));
+    depack_stream_c corrupt_depacked(corrupt_packed);
+    hard_assert(corrupt_depacked.read(buf, sizeof(buf)) == 0 && !corrupt_depacked.good());
+
+    // Memory streams unpack when loaded
+    memstream_c loaded_packed(packed, sizeof(packed));
+    memstream_c loaded(static_cast<stream_c&>(loaded_packed));
+    hard_assert(loaded.good() && loaded.size() == 21 && memcmp(loaded.data(), toybox, 21) == 0);
+
+#ifndef __M68000__
+    // Round trip through the host encoder, with reads of odd sizes
+    static constexpr size_t size = 12000;
+    auto* plain = make_packable(size);
+    auto* unpacked = static_cast<uint8_t*>(_malloc(size));
+    strstream_c trip(size + size / 255 + 32);
+    const size_t packed_size = lz_compress(trip, plain, size, 12);
+    hard_assert(packed_size > 0 && packed_size < size);
+    memstream_c trip_packed(reinterpret_cast<uint8_t*>(trip.str()), packed_size);
+    depack_stream_c trip_direct(trip_packed);
+    hard_assert(trip_direct.read(unpacked, size) == size && memcmp(plain, unpacked, size) == 0);
+    memset(unpacked, 0, size);
+    trip_packed.seek(0, stream_c::seekdir_e::beg);
+    depack_stream_c trip_window(trip_packed);
+    for (size_t pos = 0, count = 1; pos < size; pos += count, count = count * 3 % 1000 + 1) {
+        count = MIN(count, size - pos);
+        hard_assert(trip_window.read(unpacked + pos, count) == count);
+    }
+    hard_assert(memcmp(plain, unpacked, size) == 0);
+    _free(plain);
+    _free(unpacked);
+
+    // IFF parsing seeks back, over an owned packed stream
+    static const uint8_t iff_plain[] = {
+        'F', 'O', 'R', 'M', 0, 0, 0, 24, 'T', 'E', 'S', 'T',
+        'A', 'A', 'A', 'A', 0, 0, 0, 2, 1, 2,
+        'B', 'B', 'B', 'B', 0, 0, 0, 2, 3, 4
+    };
+    strstream_c iff(64);
+    const size_t iff_size = lz_compress(iff, iff_plain, sizeof(iff_plain), 8);
+    hard_assert(iff_size > 0);
+    shared_ptr_c<stream_c> iff_packed(new memstream_c(reinterpret_cast<uint8_t*>(iff.str()), iff_size));
+    iffstream_c iff_file(shared_ptr_c<stream_c>(new depack_stream_c(iff_packed)));
+    iff_packed.reset();
+    iff_group_s form;
+    iff_chunk_s chunk;
+    hard_assert(iff_file.first(cc4::FORM, cc4_t("TEST"), form));
+    hard_assert(!iff_file.next(form, cc4_t("CCCC"), chunk) && "Missing chunk must seek back");
+    hard_assert(iff_file.next(form, cc4_t("BBBB"), chunk));
+    hard_assert(iff_file.read(buf, 2) == 2 && buf[0] == 3 && buf[1] == 4);
+    hard_assert(iff_file.first(cc4::FORM, cc4_t("TEST"), form) && iff_file.next(form, cc4_t("AAAA"), chunk));
+    hard_assert(iff_file.read(buf, 2) == 2 && buf[0] == 1 && buf[1] == 2);
+#endif
+}
+
+#ifndef __M68000__
+__neverinline static void test_pack() {
+    static const char* files[] = { "/tmp/tb_b.bin", "/tmp/TB_A.bin", "/tmp/tb_c.bin" };
+    static const uint8_t sizes[] = { 5, 20, 0 };
+    for (int i = 0; i < 3; ++i) {
+        fstream_c out(files[i], fstream_c::openmode_e::output);
+        for (uint8_t j = 0; j < sizes[i]; ++j) {
+            const uint8_t byte = static_cast<uint8_t>(i * 64 + j);
+            hard_assert(out.write(&byte) == 1);
+        }
+    }
+    hard_assert(pack_c::create("/tmp/tb_test.pak", files, 3));
+    const char* duplicates[] = { files[0], "/tmp/TB_B.bin" };
+    hard_assert(!pack_c::create("/tmp/tb_dup.pak", duplicates, 2) && "Names must be unique ignoring case");
+
+    pack_c pack("/tmp/tb_test.pak");
+    hard_assert(pack.good() && pack.size() == 3);
+    hard_assert(strcmp(pack.begin()->name, "/tmp/tb_a.bin") == 0 && "Table of contents must be sorted");
+    for (const auto& entry : pack) {
+        hard_assert(entry.offset % pack_c::alignment == 0);
+    }
+    const auto* a = pack.find("\\TMP\\tb_a.BIN");
+    hard_assert(a && a->size == 20 && "Find must ignore case and separator");
+    hard_assert(pack.find("/tmp/tb_d.bin") == nullptr);
+
+    // Files are substreams of the one pack file
+    auto b = pack.open("/tmp/tb_b.bin");
+    auto c = pack.open("/tmp/tb_c.bin");
+    hard_assert(b && c && !pack.open("/tmp/tb_d.bin"));
+    uint8_t bytes[8];
+    hard_assert(c->read(bytes, 8) == 0 && "Empty file must read nothing");
+    hard_assert(b->seek(-2, stream_c::seekdir_e::end) == 3);
+    hard_assert(b->read(bytes, 8) == 2 && bytes[0] == 3 && bytes[1] == 4);
+
+    // Mounted packs are read before the file system
+    pack_c::mount(&pack);
+    remove(files[1]);
+    memstream_c mem(files[1]);
+    hard_assert(mem.good() && mem.size() == 20 && mem.data()[19] == 64 + 19);
+    pack_c::mount(nullptr);
+    memstream_c missing(files[1]);
+    hard_assert(!missing.good());
+
+    // Compressed packs unpack when loaded, files that do not shrink are stored
+    fstream_c big(files[0], fstream_c::openmode_e::output);
+    for (int i = 0; i < 1000; ++i) {
+        const uint8_t byte = static_cast<uint8_t>(i & 7);
+        hard_assert(big.write(&byte) == 1);
+    }
+    big.close();
+    hard_assert(pack_c::create("/tmp/tb_test.pak", files, 1, true));
+    pack_c compressed("/tmp/tb_test.pak");
+    hard_assert(compressed.good() && compressed.begin()->size < 1000);
+    pack_c::mount(&compressed);
+    memstream_c unpacked(files[0]);
+    hard_assert(unpacked.good() && unpacked.size() == 1000 && unpacked.data()[999] == 7);
+    pack_c::mount(nullptr);
+    remove(files[0]);
+    remove(files[2]);
+    remove("/tmp/tb_test.pak");
+}
+#endif
+
+#ifndef __M68000__
+// Records the size and first byte of its file, and counts creations.
+class test_asset_c final : public asset_c {
+public:
+    test_asset_c(const char* path) : size(0), first(0) {
+        memstream_c file(path);
+        if (file.good() && file.size() > 0) {
+            size = file.size();
+            first = file.data()[0];
+        }
+        created++;
+    }
+    static asset_c* create(const asset_manager_c& manager, const char* path) {
+        return new test_asset_c(path);
+    }
+    size_t size;
+    uint8_t first;
+    static inline int created = 0;
+};
+
+__neverinline static void test_asset_loader() {
+    // Data paths are relative, work in a data directory in /tmp.
+    char cwd[256];
+    hard_assert(getcwd(cwd, sizeof(cwd)) != nullptr);
+    hard_assert(chdir("/tmp") == 0);
+    mkdir("data", 0755);
+    static const char* files[] = { "data/tb_asset_a.bin", "data/tb_asset_b.bin" };
+    static const size_t sizes[] = { 6000, 3000 };
+    auto write_files = [] {
+        for (int i = 0; i < 2; ++i) {
+            fstream_c out(files[i], fstream_c::openmode_e::output);
+            for (size_t j = 0; j < sizes[i]; ++j) {
+                const uint8_t byte = static_cast<uint8_t>(i + 1 + j);
+                hard_assert(out.write(&byte) == 1);
+            }
+        }
+    };
+    write_files();
+
+    auto& assets = asset_manager_c::shared();
+    const asset_manager_c::asset_set_t set(15);
+    const int a = assets.add_asset_def(asset_manager_c::asset_def_s(asset_c::custom, set, "tb_asset_a.bin", &test_asset_c::create));
+    const int b = assets.add_asset_def(asset_manager_c::asset_def_s(asset_c::custom, set, "tb_asset_b.bin", &test_asset_c::create));
+    auto update_until_done = [&assets] {
+        for (int i = 0; i < 10000; ++i) {
+            if (assets.update()) {
+                return true;
+            }
+            usleep(100);
+        }
+        return false;
+    };
+
+    // Requests load in the background until ready
+    hard_assert(assets.update() && "Nothing requested must be done");
+    assets.request(set);
+    hard_assert(!assets.ready(set));
+    hard_assert(update_until_done());
+    hard_assert(assets.ready(a) && assets.ready(b) && assets.ready(set));
+    const auto& asset_a = assets.asset<test_asset_c>(a);
+    hard_assert(asset_a.size == 6000 && asset_a.first == 1);
+    hard_assert(assets.asset<test_asset_c>(b).size == 3000 && assets.asset<test_asset_c>(b).first == 2);
+
+    // Accessing an asset being loaded finishes the load
+    assets.unload(set);
+    hard_assert(!assets.ready(a) && !assets.ready(b));
+    int created = test_asset_c::created;
+    assets.request(set);
+    assets.update();
+    hard_assert(assets.asset<test_asset_c>(a).size == 6000);
+    hard_assert(test_asset_c::created == created + 1 && "Asset must be created once");
+    hard_assert(update_until_done() && assets.ready(set));
+    hard_assert(test_asset_c::created == created + 2);
+
+    // Unloading the asset being loaded cancels it
+    assets.unload(set);
+    created = test_asset_c::created;
+    assets.request(set);
+    assets.update();
+    assets.unload(a);
+    hard_assert(update_until_done());
+    hard_assert(!assets.ready(a) && assets.ready(b) && !assets.ready(set));
+    hard_assert(test_asset_c::created == created + 1 && "Cancelled asset must not be created");
+
+    // Opening a pack finishes the load in progress, then assets read from the pack
+    const char* pack_files[] = { files[0], files[1] };
+    hard_assert(pack_c::create("data/tb_assets.pak", pack_files, 2));
+    assets.unload(set);
+    assets.request(set);
+    assets.update();
+    hard_assert(assets.open_pack("tb_assets.pak"));
+    hard_assert(assets.ready(a) && "Load in progress must finish");
+    remove(files[0]);
+    remove(files[1]);
+    assets.unload(set);
+    assets.request(set);
+    hard_assert(update_until_done() && assets.ready(set));
+    hard_assert(assets.asset<test_asset_c>(a).size == 6000 && assets.asset<test_asset_c>(b).first == 2);
+
+    hard_assert(!assets.open_pack("tb_no_such.pak") && pack_c::mounted() == nullptr);
+    assets.unload(set);
+    remove("data/tb_assets.pak");
+    rmdir("data");
+    hard_assert(chdir(cwd) == 0);
+}
+#endif
+
+__neverinline void test_stream() {
+    printf("== Start: test_stream\n\r");
+    test_bufstream();
+    test_memstream();
+    test_iff_index();
+    test_inflate();
+    test_depack();
+#ifndef __M68000__
+    test_pack();
+    test_asset_loader();
+#endif
+    printf("test_stream pass.\n\r");
+}
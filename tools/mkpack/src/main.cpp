@@ -0,0 +1,59 @@
+//
+//  main.cpp
+//  mkpack
+//
+//  Created by Fredrik on 2026-10-16.
+//
+
+#include "core/pack.hpp"
+
+using namespace toybox;
+
+static void print_help() {
+    printf("mkpack - A utility for packing asset files into one toybox pack.\n");
+    printf("usage: mkpack [options] pack.pak file...\n");
+    printf("  -h    Show this help and exit.\n");
+    printf("  -l    List the contents of pack.pak and exit.\n");
+    printf("  -z    Compress files that get smaller, unpacked when loaded.\n");
+    printf("Run from the directory holding the files, names are stored as given.\n");
+}
+
+static int list_pack(const char* path) {
+    pack_c pack(path);
+    if (!pack.good()) {
+        printf("Could not open pack '%s'.\n", path);
+        return -1;
+    }
+    for (const auto& entry : pack) {
+        printf("%8u %8u %s\n", (unsigned)entry.offset, (unsigned)entry.size, entry.name);
+    }
+    return 0;
+}
+
+int main(int argc, const char* argv[]) {
+    if (argc < 2 || strcmp(argv[1], "-h") == 0) {
+        print_help();
+        return 0;
+    }
+    if (strcmp(argv[1], "-l") == 0) {
+        if (argc != 3) {
+            printf("No pack file.\n");
+            return -1;
+        }
+        return list_pack(argv[2]);
+    }
+    int first = 1;
+    const bool compress = strcmp(argv[1], "-z") == 0;
+    if (compress) {
+        first++;
+    }
+    if (argc < first + 2) {
+        printf("No files to pack.\n");
+        return -1;
+    }
+    if (!pack_c::create(argv[first], &argv[first + 1], argc - first - 1, compress)) {
+        printf("Could not create pack '%s'.\n", argv[first]);
+        return -1;
+    }
+    return 0;
+}
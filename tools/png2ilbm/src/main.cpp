@@ -36,7 +36,7 @@ const arg_handlers_t arg_handlers {
         masked_idx = atoi(args.front());
         args.pop_front();
     }}},
-    {"-c type",          {"Save compressed.", [] (arguments_t& args) {
+    {"-c type",          {"Save compressed, 0 none, 1 packbits, 3 deflate.", [] (arguments_t& args) {
         compression = (image_c::compression_type_e)atoi(args.front());
         args.pop_front();
     }}},